@@ -0,0 +1,169 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "Util.h"
+#include "FbxLoader.h"
+#include "MeshCache.h"
+#include "AssetPack.h"
+#include "AssetCook.h"
+
+//에셋 쿠커: Resources 아래 FBX와 텍스처를 실행용 모양으로 구워 에셋 팩 하나로 묶음
+//AssetCooker.exe [리소스 폴더] [팩 경로]
+//이전 팩에 원본 해시가 같은 항목이 있으면 다시 굽지 않고 그대로 옮김
+
+#define COOK_THREAD_COUNT 0 //0이면 코어 수만큼
+
+//굽기 대상 하나
+struct CookJob
+{
+	fs::path path;
+	uint32_t type = 0;
+	AssetPackItem item;
+	bool reused = false;
+	bool failed = false;
+	MeshCookStats stats; //새로 구운 메쉬만
+};
+
+//굽기 대상인지, 구운 결과물(.bc.dds, .meshcache, .pak)과 모르는 확장자는 뺌
+static uint32_t AssetTypeOf(const fs::path& path)
+{
+	wstring name = path.filename().wstring();
+	for (wchar_t& ch : name)
+		ch = towlower(ch);
+	auto endsWith = [&](const wchar_t* suffix) {
+		size_t length = wcslen(suffix);
+		return name.size() > length && name.compare(name.size() - length, length, suffix) == 0;
+	};
+
+	if (endsWith(L".bc.dds"))
+		return 0;
+	if (endsWith(L".fbx"))
+		return ASSET_MESH;
+	for (const wchar_t* ext : { L".dds", L".png", L".jpg", L".jpeg", L".bmp", L".tga" })
+	{
+		if (endsWith(ext))
+			return ASSET_TEXTURE;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	fs::path resourceDir = argc > 1 ? argv[1] : "../Resources";
+	string packPath = argc > 2 ? argv[2] : ASSET_PACK_PATH;
+	auto startTime = chrono::steady_clock::now();
+
+	//팩 이름은 Resources 기준이라 실행할 때 넘기는 경로 ("../Resources/...")와 같아짐
+	vector<CookJob> jobs;
+	error_code ec;
+	for (fs::recursive_directory_iterator it(resourceDir, ec), end; it != end; it.increment(ec))
+	{
+		if (ec)
+			break;
+		if (!it->is_regular_file(ec))
+			continue;
+		uint32_t type = AssetTypeOf(it->path());
+		if (type == 0)
+			continue;
+
+		CookJob job;
+		job.path = it->path();
+		job.type = type;
+		job.item.name = AssetNameFromPath(fs::relative(it->path(), resourceDir, ec).string());
+		job.item.type = type;
+		jobs.push_back(std::move(job));
+	}
+	if (ec)
+	{
+		printf("asset cooker: cannot read %s\n", resourceDir.string().c_str());
+		return 1;
+	}
+
+	//이전 팩, 쓰기 전에 닫아야 하므로 쓸 항목은 복사해 둠
+	AssetPack oldPack;
+	oldPack.Open(packPath.c_str());
+
+	int threadCount = COOK_THREAD_COUNT > 0 ? COOK_THREAD_COUNT : max(1, static_cast<int>(thread::hardware_concurrency()));
+	atomic<size_t> nextJob = 0;
+	mutex fbxMutex; //FBX SDK 로드는 한 번에 하나, LOD 만들기와 텍스처는 병렬
+	FbxLoader fbxLoader;
+
+	auto worker = [&]() {
+		for (size_t index = nextJob++; index < jobs.size(); index = nextJob++)
+		{
+			CookJob& job = jobs[index];
+			if (job.type == ASSET_MESH)
+				job.item.sourceHash = MeshSourceHash(job.path.string().c_str());
+			else
+				job.item.sourceHash = TextureSourceHash(job.path.wstring());
+			if (job.item.sourceHash == 0)
+			{
+				job.failed = true;
+				continue;
+			}
+
+			const AssetPackEntry* old = oldPack.IsOpen() ? oldPack.Find(job.item.name) : nullptr;
+			if (old && old->type == job.type && old->sourceHash == job.item.sourceHash)
+			{
+				const uint8_t* data = oldPack.GetData(*old);
+				job.item.data.assign(data, data + old->size);
+				job.reused = true;
+				continue;
+			}
+
+			if (job.type == ASSET_MESH)
+			{
+				vector<Vertex> vertexVec;
+				vector<UINT> indexVec;
+				MeshBounds bounds;
+				bool loaded;
+				{
+					lock_guard<mutex> lock(fbxMutex);
+					loaded = fbxLoader.LoadFbxData(vertexVec, indexVec, job.path.string().c_str(), &bounds);
+				}
+				job.failed = !loaded || !BuildMeshCache(job.item.sourceHash, vertexVec, indexVec, bounds, job.item.data, &job.stats);
+			}
+			else
+			{
+				job.failed = !CookTexture(job.path.wstring(), job.item.data);
+			}
+		}
+	};
+
+	vector<thread> threads;
+	for (int i = 1; i < threadCount; i++)
+		threads.emplace_back(worker);
+	worker();
+	for (thread& t : threads)
+		t.join();
+	oldPack.Close();
+
+	vector<AssetPackItem> items;
+	int cookedCount = 0, reusedCount = 0, failedCount = 0;
+	for (CookJob& job : jobs)
+	{
+		if (job.failed)
+		{
+			printf("  failed  %s\n", job.item.name.c_str());
+			failedCount++;
+			continue;
+		}
+		printf("  %s  %s (%zu bytes)\n", job.reused ? "reused" : "cooked", job.item.name.c_str(), job.item.data.size());
+		if (job.type == ASSET_MESH && !job.reused)
+			printf("          ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", job.stats.before.acmr, job.stats.after.acmr, job.stats.before.atvr, job.stats.after.atvr);
+		(job.reused ? reusedCount : cookedCount)++;
+		items.push_back(std::move(job.item));
+	}
+
+	if (!WriteAssetPack(packPath.c_str(), items))
+	{
+		printf("asset cooker: failed to write %s\n", packPath.c_str());
+		return 1;
+	}
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	printf("asset cooker: %s, %d cooked, %d reused, %d failed, %d threads, %.2f s\n", packPath.c_str(), cookedCount, reusedCount, failedCount, threadCount, seconds);
+	return failedCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+#include "AssetCook.h"
+#include "MeshSimplify.h"
+#include "MeshCache.h"
+#include "MipGen.h"
+#include "BcEncode.h"
+
+//FbxLoader나 LOD, 정점 정리 방법, 캐시 모양이 바뀌어 같은 원본에서 다른 결과가 나오면 올림
+constexpr uint32_t MESH_COOK_VERSION = 4;
+
+uint64_t MeshSourceHash(const char* path)
+{
+	//원본 해시에 LOD 설정도 섞어서, 설정이 바뀌어도 캐시를 다시 만들게 함
+	uint64_t sourceHash = HashFile(path);
+	if (sourceHash != 0)
+	{
+		float lodReduction = LOD_REDUCTION;
+		float overdrawThreshold = MESH_OVERDRAW_THRESHOLD;
+		uint32_t vertexStride = sizeof(GpuVertex);
+		uint32_t cookVersion = MESH_COOK_VERSION;
+		sourceHash = Fnv1a(&lodReduction, sizeof(lodReduction), sourceHash);
+		sourceHash = Fnv1a(&overdrawThreshold, sizeof(overdrawThreshold), sourceHash);
+		sourceHash = Fnv1a(&vertexStride, sizeof(vertexStride), sourceHash);
+		sourceHash = Fnv1a(&cookVersion, sizeof(cookVersion), sourceHash);
+	}
+	return sourceHash;
+}
+
+bool BuildMeshCache(uint64_t sourceHash, vector<Vertex>& vertexVec, const vector<UINT>& indexVec, const MeshBounds& bounds, vector<uint8_t>& out, MeshCookStats* stats)
+{
+	out.clear();
+	if (vertexVec.empty() || indexVec.empty())
+		return false;
+
+	vector<vector<UINT>> lodVec;
+	BuildLodChain(&vertexVec[0].pos.x, sizeof(Vertex), vertexVec.size(), indexVec, MESH_LOD_COUNT, LOD_REDUCTION, lodVec); //멀리 있을 때 쓸 LOD
+	if (stats)
+		stats->before = AnalyzeVertexCache(lodVec[0], vertexVec.size());
+
+	//LOD마다 정점 캐시 순서 -> 오버드로우 순서로 삼각형을 정리하고 이어 붙여 공유 버퍼에 올릴 모양으로
+	vector<UINT> lodIndices;
+	vector<UINT> cacheOrder, overdrawOrder;
+	MeshCacheLod cacheLods[MESH_LOD_COUNT];
+	for (int lod = 0; lod < MESH_LOD_COUNT; lod++)
+	{
+		OptimizeVertexCache(lodVec[lod], vertexVec.size(), cacheOrder);
+		OptimizeOverdraw(&vertexVec[0].pos.x, sizeof(Vertex), vertexVec.size(), cacheOrder, MESH_OVERDRAW_THRESHOLD, overdrawOrder);
+		cacheLods[lod] = { static_cast<uint32_t>(lodIndices.size()), static_cast<uint32_t>(overdrawOrder.size()) };
+		lodIndices.insert(lodIndices.end(), overdrawOrder.begin(), overdrawOrder.end());
+	}
+
+	//정점은 LOD 0부터 처음 쓰이는 순서로 (LOD들이 정점 버퍼 하나를 같이 씀)
+	size_t usedCount = OptimizeVertexFetch(vertexVec.data(), sizeof(Vertex), vertexVec.size(), lodIndices);
+	vertexVec.resize(usedCount);
+	if (stats)
+		stats->after = AnalyzeVertexCache(vector<UINT>(lodIndices.begin(), lodIndices.begin() + cacheLods[0].indexCount), vertexVec.size());
+
+#if PACKED_VERTEX
+	//정점 버퍼에 올릴 모양으로 양자화, 범위는 메쉬 AABB (MeshRegistry가 같은 범위로 되돌림)
+	float boxMin[3], boxSize[3];
+	PositionQuantizationRange(&bounds.box.Center.x, &bounds.box.Extents.x, boxMin, boxSize);
+	vector<GpuVertex> gpuVertices(vertexVec.size());
+	for (size_t i = 0; i < vertexVec.size(); i++)
+		PackVertex(&vertexVec[i].pos.x, &vertexVec[i].color.x, &vertexVec[i].uv.x, boxMin, boxSize, gpuVertices[i]);
+#else
+	const vector<GpuVertex>& gpuVertices = vertexVec;
+#endif
+
+	MeshCacheBounds cacheBounds;
+	memcpy(cacheBounds.boxCenter, &bounds.box.Center, sizeof(cacheBounds.boxCenter));
+	memcpy(cacheBounds.boxExtents, &bounds.box.Extents, sizeof(cacheBounds.boxExtents));
+	memcpy(cacheBounds.sphereCenter, &bounds.sphere.Center, sizeof(cacheBounds.sphereCenter));
+	cacheBounds.sphereRadius = bounds.sphere.Radius;
+
+	return SerializeMeshCache(sourceHash, gpuVertices.data(), sizeof(GpuVertex), static_cast<uint32_t>(gpuVertices.size()),
+		lodIndices.data(), static_cast<uint32_t>(lodIndices.size()), cacheLods, MESH_LOD_COUNT, cacheBounds, out);
+}
+
+wstring BakedTexturePath(const wstring& path)
+{
+	return fs::path(path).replace_extension(L".bc.dds").wstring();
+}
+
+uint64_t TextureSourceHash(const wstring& path)
+{
+	uint64_t sourceHash = HashFile(fs::path(path).string().c_str());
+	if (sourceHash != 0)
+	{
+		uint32_t bc7 = TEXTURE_BAKE_BC7;
+		sourceHash = Fnv1a(&bc7, sizeof(bc7), sourceHash);
+	}
+	return sourceHash;
+}
+
+//확장자별로 로드
+static HRESULT LoadImageFile(const wstring& path, ScratchImage& image)
+{
+	wstring ext = fs::path(path).extension();
+
+	if (ext == L".dds" || ext == L".DDS") //dds
+		return LoadFromDDSFile(path.c_str(), DDS_FLAGS_NONE, nullptr, image);
+	else if (ext == L".tga" || ext == L".TGA") //tga
+		return LoadFromTGAFile(path.c_str(), nullptr, image);
+	else //png, jpg, jpeg, bmp
+		return LoadFromWICFile(path.c_str(), WIC_FLAGS_NONE, nullptr, image);
+}
+
+//ScratchImage -> TextureData, 2D 텍스처 한 장만 (배열, 큐브는 첫 장)
+static void ToTextureData(const ScratchImage& image, TextureData& data)
+{
+	const TexMetadata& meta = image.GetMetadata();
+	data.width = static_cast<uint32_t>(meta.width);
+	data.height = static_cast<uint32_t>(meta.height);
+	data.format = static_cast<uint32_t>(meta.format);
+	data.pixels.assign(image.GetPixels(), image.GetPixels() + image.GetPixelsSize());
+	data.mips.resize(meta.mipLevels);
+	for (size_t i = 0; i < meta.mipLevels; i++)
+	{
+		const Image* mip = image.GetImage(i, 0, 0);
+		data.mips[i].offset = static_cast<uint64_t>(mip->pixels - image.GetPixels());
+		data.mips[i].width = static_cast<uint32_t>(mip->width);
+		data.mips[i].height = static_cast<uint32_t>(mip->height);
+		data.mips[i].rowPitch = static_cast<uint32_t>(mip->rowPitch);
+		data.mips[i].rowCount = static_cast<uint32_t>(mip->slicePitch / mip->rowPitch);
+	}
+}
+
+//파일 이름으로 노멀맵 구분 (_n, _normal, _nrm)
+static bool IsNormalMapPath(const wstring& path)
+{
+	wstring stem = fs::path(path).stem().wstring();
+	for (wchar_t& ch : stem)
+		ch = towlower(ch);
+	for (const wchar_t* suffix : { L"_n", L"_normal", L"_nrm" })
+	{
+		size_t length = wcslen(suffix);
+		if (stem.size() > length && stem.compare(stem.size() - length, length, suffix) == 0)
+			return true;
+	}
+	return false;
+}
+
+bool LoadTextureSource(const wstring& path, TextureData& data)
+{
+	//WIC는 스레드마다 COM 초기화가 필요
+	static thread_local HRESULT comInit = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	(void)comInit;
+
+	ScratchImage image;
+	if (FAILED(LoadImageFile(path, image)))
+		return false;
+
+	//밉이 없는 8비트 RGBA는 아래 GenerateMips가 만들고, 나머지 비압축 포맷은 DirectXTex로
+	if (image.GetMetadata().mipLevels == 1 && !CanGenerateMips(image.GetMetadata().format) && !IsCompressed(image.GetMetadata().format))
+	{
+		ScratchImage mipChain;
+		if (SUCCEEDED(GenerateMipMaps(*image.GetImage(0, 0, 0), TEX_FILTER_BOX, 0, mipChain)))
+			image = std::move(mipChain);
+	}
+
+	ToTextureData(image, data);
+	GenerateMips(data);
+	return true;
+}
+
+bool CompressTextureData(const wstring& path, TextureData& data)
+{
+	uint32_t format = ChooseBcFormat(data, IsNormalMapPath(path));
+	if (format == 0)
+		return false;
+
+	TextureData compressed;
+	bool ok = false;
+#if TEXTURE_BAKE_BC7
+	//색 텍스처는 BC7 (DirectXTex 인코더, 느리지만 BC1/BC3보다 화질이 좋음)
+	if (format != FORMAT_BC5_UNORM)
+	{
+		vector<Image> images(data.mips.size());
+		for (size_t i = 0; i < data.mips.size(); i++)
+		{
+			const TextureMip& mip = data.mips[i];
+			images[i] = { mip.width, mip.height, static_cast<DXGI_FORMAT>(data.format), mip.rowPitch, static_cast<size_t>(mip.rowPitch) * mip.rowCount, &data.pixels[mip.offset] };
+		}
+		TexMetadata meta = {};
+		meta.width = data.width;
+		meta.height = data.height;
+		meta.depth = 1;
+		meta.arraySize = 1;
+		meta.mipLevels = data.mips.size();
+		meta.format = static_cast<DXGI_FORMAT>(data.format);
+		meta.dimension = TEX_DIMENSION_TEXTURE2D;
+
+		ScratchImage bc7;
+		DXGI_FORMAT bc7Format = IsSRGB(meta.format) ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+		if (SUCCEEDED(Compress(images.data(), images.size(), meta, bc7Format, TEX_COMPRESS_PARALLEL, TEX_THRESHOLD_DEFAULT, bc7)))
+		{
+			ToTextureData(bc7, compressed);
+			ok = true;
+		}
+	}
+#endif
+	if (!ok)
+		ok = CompressTexture(data, format, compressed);
+	if (!ok)
+		return false;
+
+	data = std::move(compressed);
+	return true;
+}
+
+bool LoadDdsMemory(const uint8_t* bytes, size_t size, TextureData& data)
+{
+	ScratchImage image;
+	if (FAILED(LoadFromDDSMemory(bytes, size, DDS_FLAGS_NONE, nullptr, image)))
+		return false;
+	ToTextureData(image, data);
+	return true;
+}
+
+bool LoadDdsFile(const wstring& path, TextureData& data)
+{
+	ScratchImage image;
+	if (FAILED(LoadFromDDSFile(path.c_str(), DDS_FLAGS_NONE, nullptr, image)))
+		return false;
+	ToTextureData(image, data);
+	return true;
+}
+
+bool CookTexture(const wstring& path, vector<uint8_t>& out)
+{
+	TextureData data;
+	if (!LoadTextureSource(path, data))
+		return false;
+	CompressTextureData(path, data); //압축할 수 없는 포맷은 밉만 만든 채로
+	SerializeDds(data, out);
+	return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Util.h"
+#include "TextureStream.h"
+#include "MeshOptimize.h"
+
+//메쉬, 텍스처를 실행용 모양으로 굽기 (GPU 없이 동작)
+//DxEngine이 낱개 캐시를 만들 때와 AssetCooker가 에셋 팩을 만들 때 같은 코드를 씀
+
+//메쉬 원본 해시 (파일 + LOD 설정), 원본이 없으면 0
+uint64_t MeshSourceHash(const char* path);
+
+//메쉬 굽기 전후 LOD 0의 정점 캐시 효율
+struct MeshCookStats
+{
+	VertexCacheStats before;
+	VertexCacheStats after;
+};
+
+//FBX에서 읽은 정점, 인덱스로 LOD를 만들고 캐시, 오버드로우, 정점 읽기 순서로 정리해 메쉬 캐시 내용으로 만듦
+//vertexVec은 순서가 바뀌고 안 쓰는 정점이 빠짐. 입력이 비었거나 인덱스가 정점 범위를 벗어나면 false (out은 비움)
+bool BuildMeshCache(uint64_t sourceHash, vector<Vertex>& vertexVec, const vector<UINT>& indexVec, const MeshBounds& bounds, vector<uint8_t>& out, MeshCookStats* stats = nullptr);
+
+//구운 텍스처는 소스 옆에 (bricks.png -> bricks.bc.dds)
+wstring BakedTexturePath(const wstring& path);
+
+//텍스처 원본 해시 (파일 + 압축 설정), 원본이 없으면 0
+uint64_t TextureSourceHash(const wstring& path);
+
+//이미지 파일 -> 밉까지 만든 TextureData (WIC를 쓰므로 스레드마다 COM 초기화함)
+bool LoadTextureSource(const wstring& path, TextureData& data);
+
+//밉까지 만든 8비트 텍스처를 BC로 압축, 압축할 수 없으면 false (data 그대로)
+bool CompressTextureData(const wstring& path, TextureData& data);
+
+//메모리에 있는 DDS (구운 텍스처, 에셋 팩 항목) -> TextureData
+bool LoadDdsMemory(const uint8_t* bytes, size_t size, TextureData& data);
+bool LoadDdsFile(const wstring& path, TextureData& data);
+
+//원본 -> 압축한 DDS 파일 내용
+bool CookTexture(const wstring& path, vector<uint8_t>& out);
@@ -0,0 +1,131 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+std::string AssetNameFromPath(const std::string& path)
+{
+	std::string name = path;
+	for (char& ch : name)
+	{
+		ch = static_cast<char>(tolower(static_cast<unsigned char>(ch)));
+		if (ch == '\\')
+			ch = '/';
+	}
+
+	const char root[] = "resources/";
+	size_t pos = name.rfind(root);
+	if (pos != std::string::npos)
+		name.erase(0, pos + sizeof(root) - 1);
+	while (name.compare(0, 2, "./") == 0)
+		name.erase(0, 2);
+	return name;
+}
+
+bool AssetPack::Open(const char* path)
+{
+	Close();
+	if (!_file.Open(path) || _file._size < sizeof(AssetPackHeader))
+	{
+		Close();
+		return false;
+	}
+
+	AssetPackHeader header;
+	memcpy(&header, _file._data, sizeof(header));
+	uint64_t tocBytes = static_cast<uint64_t>(header.entryCount) * sizeof(AssetPackEntry);
+	if (memcmp(header.magic, "APAK", 4) != 0 || header.version != ASSET_PACK_VERSION || header.fileSize != _file._size
+		|| header.tocOffset % 8 != 0 || header.tocOffset + tocBytes > header.namesOffset || header.namesOffset > _file._size)
+	{
+		Close();
+		return false;
+	}
+
+	const AssetPackEntry* entries = reinterpret_cast<const AssetPackEntry*>(_file._data + header.tocOffset);
+	uint64_t namesSize = _file._size - header.namesOffset;
+	for (uint32_t i = 0; i < header.entryCount; i++)
+	{
+		const AssetPackEntry& entry = entries[i];
+		if (entry.offset % ASSET_PACK_ALIGN != 0 || entry.offset + entry.size > header.tocOffset
+			|| static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > namesSize)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	_entries = entries;
+	_entryCount = header.entryCount;
+	_names = reinterpret_cast<const char*>(_file._data + header.namesOffset);
+	return true;
+}
+
+void AssetPack::Close()
+{
+	_file.Close();
+	_entries = nullptr;
+	_entryCount = 0;
+	_names = nullptr;
+}
+
+const AssetPackEntry* AssetPack::Find(const std::string& name) const
+{
+	uint32_t lo = 0, hi = _entryCount;
+	while (lo < hi)
+	{
+		uint32_t mid = (lo + hi) / 2;
+		const AssetPackEntry& entry = _entries[mid];
+		int cmp = name.compare(0, std::string::npos, _names + entry.nameOffset, entry.nameLength);
+		if (cmp == 0)
+			return &entry;
+		if (cmp < 0)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return nullptr;
+}
+
+bool WriteAssetPack(const char* path, std::vector<AssetPackItem>& items)
+{
+	std::sort(items.begin(), items.end(), [](const AssetPackItem& a, const AssetPackItem& b) { return a.name < b.name; });
+
+	//헤더, 항목 데이터 (64바이트 정렬), 목차, 이름 순서로 배치
+	std::vector<AssetPackEntry> entries(items.size());
+	std::string names;
+	uint64_t offset = ASSET_PACK_ALIGN; //헤더 자리
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		entries[i] = {};
+		entries[i].offset = offset;
+		entries[i].size = items[i].data.size();
+		entries[i].sourceHash = items[i].sourceHash;
+		entries[i].type = items[i].type;
+		entries[i].nameOffset = static_cast<uint32_t>(names.size());
+		entries[i].nameLength = static_cast<uint32_t>(items[i].name.size());
+		names += items[i].name;
+		offset = (offset + items[i].data.size() + ASSET_PACK_ALIGN - 1) & ~(ASSET_PACK_ALIGN - 1);
+	}
+
+	AssetPackHeader header = {};
+	memcpy(header.magic, "APAK", 4);
+	header.version = ASSET_PACK_VERSION;
+	header.entryCount = static_cast<uint32_t>(items.size());
+	header.tocOffset = offset;
+	header.namesOffset = offset + entries.size() * sizeof(AssetPackEntry);
+	header.fileSize = header.namesOffset + names.size();
+
+	std::vector<uint8_t> bytes(static_cast<size_t>(header.fileSize), 0);
+	memcpy(bytes.data(), &header, sizeof(header));
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		if (!items[i].data.empty())
+			memcpy(bytes.data() + entries[i].offset, items[i].data.data(), items[i].data.size());
+	}
+	if (!entries.empty())
+		memcpy(bytes.data() + header.tocOffset, entries.data(), entries.size() * sizeof(AssetPackEntry));
+	if (!names.empty())
+		memcpy(bytes.data() + header.namesOffset, names.data(), names.size());
+
+	return WriteFileAtomic(path, bytes.data(), bytes.size());
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MeshCache.h"
+
+//에셋 팩 (GPU 없이 동작)
+//AssetCooker가 Resources를 구워 파일 하나로 묶은 것. 헤더 + 항목 데이터 + 목차(이름순) + 이름 문자열.
+//실행할 때는 팩을 매핑만 하고 이름으로 항목을 찾아 그 주소에서 바로 읽는다.
+//메쉬 항목은 메쉬 캐시 파일 내용, 텍스처 항목은 DDS 파일 내용 그대로. 리틀 엔디안 기준
+
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr uint64_t ASSET_PACK_ALIGN = 64; //항목 시작 정렬 (메쉬 캐시는 16바이트 정렬이 필요)
+
+enum ASSET_TYPE : uint32_t
+{
+	ASSET_MESH = 1,
+	ASSET_TEXTURE = 2,
+};
+
+struct AssetPackHeader
+{
+	char magic[4]; //"APAK"
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t padding;
+	uint64_t tocOffset;
+	uint64_t namesOffset;
+	uint64_t fileSize;
+};
+static_assert(sizeof(AssetPackHeader) == 40, "asset pack header layout changed, bump ASSET_PACK_VERSION");
+
+struct AssetPackEntry
+{
+	uint64_t offset; //파일 처음부터
+	uint64_t size;
+	uint64_t sourceHash; //굽기 전 원본 + 굽기 설정, 다시 구울지 판단용
+	uint32_t type; //ASSET_TYPE
+	uint32_t nameOffset; //이름 문자열 영역 안에서
+	uint32_t nameLength;
+	uint32_t padding;
+};
+static_assert(sizeof(AssetPackEntry) == 40, "asset pack entry layout changed, bump ASSET_PACK_VERSION");
+
+//경로 -> 팩 안 이름 (소문자, '/' 구분, "Resources/" 앞부분 제거)
+//"..\\Resources\\Texture\\bricks.dds" -> "texture/bricks.dds"
+std::string AssetNameFromPath(const std::string& path);
+
+//매핑한 팩 읽기
+class AssetPack
+{
+public:
+	bool Open(const char* path);
+	void Close();
+	bool IsOpen() const { return _entries != nullptr; }
+
+	//이름으로 찾기 (목차가 이름순이라 이진 탐색), 없으면 nullptr
+	const AssetPackEntry* Find(const std::string& name) const;
+	const uint8_t* GetData(const AssetPackEntry& entry) const { return _file._data + entry.offset; }
+	std::string GetName(const AssetPackEntry& entry) const { return std::string(_names + entry.nameOffset, entry.nameLength); }
+
+	uint32_t GetEntryCount() const { return _entryCount; }
+	const AssetPackEntry& GetEntry(uint32_t index) const { return _entries[index]; }
+
+private:
+	MappedFile _file;
+	const AssetPackEntry* _entries = nullptr;
+	uint32_t _entryCount = 0;
+	const char* _names = nullptr;
+};
+
+//팩에 넣을 항목 하나
+struct AssetPackItem
+{
+	std::string name;
+	uint32_t type = 0;
+	uint64_t sourceHash = 0;
+	std::vector<uint8_t> data;
+};
+
+//items를 이름순으로 정렬해 팩으로 씀 (임시 파일에 쓰고 이름 바꿈)
+bool WriteAssetPack(const char* path, std::vector<AssetPackItem>& items);
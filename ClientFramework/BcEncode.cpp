@@ -0,0 +1,458 @@
+#include "BcEncode.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <filesystem>
+
+static uint16_t PackRgb565(const float c[3])
+{
+	int r = std::clamp(static_cast<int>(c[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+	int g = std::clamp(static_cast<int>(c[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+	int b = std::clamp(static_cast<int>(c[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRgb565(uint16_t c, int out[3])
+{
+	int r = (c >> 11) & 31;
+	int g = (c >> 5) & 63;
+	int b = c & 31;
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+//c0, c1으로 4색 팔레트를 만들고 픽셀마다 가장 가까운 색 고름, 오차 합 반환
+static int PickBc1Indices(const uint8_t rgba[64], uint16_t c0, uint16_t c1, uint32_t& indices)
+{
+	int palette[4][3];
+	UnpackRgb565(c0, palette[0]);
+	UnpackRgb565(c1, palette[1]);
+	for (int k = 0; k < 3; k++)
+	{
+		palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+		palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+	}
+
+	int error = 0;
+	indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		const uint8_t* p = rgba + i * 4;
+		int best = 0;
+		int bestDist = 0x7FFFFFFF;
+		for (int j = 0; j < 4; j++)
+		{
+			int dr = p[0] - palette[j][0], dg = p[1] - palette[j][1], db = p[2] - palette[j][2];
+			int dist = dr * dr + dg * dg + db * db;
+			if (dist < bestDist)
+			{
+				bestDist = dist;
+				best = j;
+			}
+		}
+		indices |= static_cast<uint32_t>(best) << (2 * i);
+		error += bestDist;
+	}
+	return error;
+}
+
+static void WriteBc1(uint16_t c0, uint16_t c1, uint32_t indices, uint8_t out[8])
+{
+	out[0] = static_cast<uint8_t>(c0);
+	out[1] = static_cast<uint8_t>(c0 >> 8);
+	out[2] = static_cast<uint8_t>(c1);
+	out[3] = static_cast<uint8_t>(c1 >> 8);
+	for (int i = 0; i < 4; i++)
+		out[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+//끝점 둘을 565로 양자화하고 4색 모드(c0 > c1)가 되도록 정렬
+static void QuantizeEndpoints(const float e0[3], const float e1[3], uint16_t& c0, uint16_t& c1, bool& swapped)
+{
+	c0 = PackRgb565(e0);
+	c1 = PackRgb565(e1);
+	swapped = c0 < c1;
+	if (swapped)
+		std::swap(c0, c1);
+}
+
+void EncodeBc1Block(const uint8_t rgba[64], uint8_t out[8])
+{
+	//평균과 공분산
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+		for (int k = 0; k < 3; k++)
+			mean[k] += rgba[i * 4 + k];
+	for (int k = 0; k < 3; k++)
+		mean[k] /= 16.0f;
+
+	float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }; //xx xy xz yy yz zz
+	for (int i = 0; i < 16; i++)
+	{
+		float d[3] = { rgba[i * 4] - mean[0], rgba[i * 4 + 1] - mean[1], rgba[i * 4 + 2] - mean[2] };
+		cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+		cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+	}
+
+	//거듭제곱법으로 주성분 축
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+	for (int iter = 0; iter < 4; iter++)
+	{
+		float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+		float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+		float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+		float len = std::max(std::max(fabsf(x), fabsf(y)), fabsf(z));
+		if (len < 1e-6f)
+			break; //단색 블록
+		axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+	}
+
+	//축에 투영한 최소/최대를 끝점으로, 양 끝을 1/16씩 안쪽으로
+	float minT = 1e30f, maxT = -1e30f;
+	for (int i = 0; i < 16; i++)
+	{
+		float t = (rgba[i * 4] - mean[0]) * axis[0] + (rgba[i * 4 + 1] - mean[1]) * axis[1] + (rgba[i * 4 + 2] - mean[2]) * axis[2];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	float axisLen2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+	float inset = (maxT - minT) / 16.0f;
+	float e0[3], e1[3];
+	for (int k = 0; k < 3; k++)
+	{
+		e0[k] = mean[k] + axis[k] * (maxT - inset) / axisLen2;
+		e1[k] = mean[k] + axis[k] * (minT + inset) / axisLen2;
+	}
+
+	uint16_t c0, c1;
+	bool swapped;
+	QuantizeEndpoints(e0, e1, c0, c1, swapped);
+	if (c0 == c1)
+	{
+		WriteBc1(c0, c1, 0, out); //단색
+		return;
+	}
+	uint32_t indices;
+	int error = PickBc1Indices(rgba, c0, c1, indices);
+
+	//고른 인덱스로 끝점을 최소제곱으로 다시 맞춰보고 오차가 줄면 채택
+	static const float weight[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f }; //c0쪽 가중치
+	float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+	float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+	{
+		float a = weight[(indices >> (2 * i)) & 3];
+		float b = 1.0f - a;
+		aa += a * a; bb += b * b; ab += a * b;
+		for (int k = 0; k < 3; k++)
+		{
+			ax[k] += a * rgba[i * 4 + k];
+			bx[k] += b * rgba[i * 4 + k];
+		}
+	}
+	float det = aa * bb - ab * ab;
+	if (fabsf(det) > 1e-6f)
+	{
+		float r0[3], r1[3];
+		for (int k = 0; k < 3; k++)
+		{
+			r0[k] = (ax[k] * bb - bx[k] * ab) / det;
+			r1[k] = (bx[k] * aa - ax[k] * ab) / det;
+		}
+		uint16_t d0, d1;
+		bool refinedSwapped;
+		QuantizeEndpoints(r0, r1, d0, d1, refinedSwapped);
+		if (d0 != d1)
+		{
+			uint32_t refinedIndices;
+			int refinedError = PickBc1Indices(rgba, d0, d1, refinedIndices);
+			if (refinedError < error)
+			{
+				c0 = d0;
+				c1 = d1;
+				indices = refinedIndices;
+			}
+		}
+	}
+	WriteBc1(c0, c1, indices, out);
+}
+
+//채널 하나 (rgba[i * 4 + channel])를 BC4 8값 모드로
+static void EncodeBc4Block(const uint8_t rgba[64], int channel, uint8_t out[8])
+{
+	int lo = 255, hi = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		lo = std::min<int>(lo, rgba[i * 4 + channel]);
+		hi = std::max<int>(hi, rgba[i * 4 + channel]);
+	}
+	out[0] = static_cast<uint8_t>(hi);
+	out[1] = static_cast<uint8_t>(lo);
+
+	uint64_t indices = 0;
+	if (hi > lo)
+	{
+		//팔레트 순서: 0 = hi, 1 = lo, 2~7 = hi에서 lo쪽으로 1/7씩
+		//값 v에 가장 가까운 단계 s (0 = hi ... 7 = lo)를 구해 인덱스로 바꿈
+		static const int stepToIndex[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+		int range = hi - lo;
+		for (int i = 0; i < 16; i++)
+		{
+			int v = rgba[i * 4 + channel];
+			int step = ((hi - v) * 14 + range) / (2 * range);
+			indices |= static_cast<uint64_t>(stepToIndex[step]) << (3 * i);
+		}
+	}
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+void EncodeBc3Block(const uint8_t rgba[64], uint8_t out[16])
+{
+	EncodeBc4Block(rgba, 3, out);
+	EncodeBc1Block(rgba, out + 8);
+}
+
+void EncodeBc5Block(const uint8_t rgba[64], uint8_t out[16])
+{
+	EncodeBc4Block(rgba, 0, out);
+	EncodeBc4Block(rgba, 1, out + 8);
+}
+
+static bool IsBgra(uint32_t format)
+{
+	return format == FORMAT_B8G8R8A8_UNORM || format == FORMAT_B8G8R8X8_UNORM || format == FORMAT_B8G8R8A8_UNORM_SRGB || format == FORMAT_B8G8R8X8_UNORM_SRGB;
+}
+
+static bool IsSrgbFormat(uint32_t format)
+{
+	return format == FORMAT_R8G8B8A8_UNORM_SRGB || format == FORMAT_B8G8R8A8_UNORM_SRGB || format == FORMAT_B8G8R8X8_UNORM_SRGB;
+}
+
+uint32_t ChooseBcFormat(const TextureData& data, bool normalMap)
+{
+	if (!CanGenerateMips(data.format) || data.mips.empty() || data.width % 4 != 0 || data.height % 4 != 0)
+		return 0;
+	if (normalMap)
+		return FORMAT_BC5_UNORM;
+
+	bool srgb = IsSrgbFormat(data.format);
+	bool hasAlpha = false;
+	if (data.format != FORMAT_B8G8R8X8_UNORM && data.format != FORMAT_B8G8R8X8_UNORM_SRGB)
+	{
+		const TextureMip& top = data.mips[0];
+		for (uint32_t y = 0; y < top.height && !hasAlpha; y++)
+		{
+			const uint8_t* row = &data.pixels[top.offset + y * top.rowPitch];
+			for (uint32_t x = 0; x < top.width; x++)
+			{
+				if (row[x * 4 + 3] != 255)
+				{
+					hasAlpha = true;
+					break;
+				}
+			}
+		}
+	}
+	if (hasAlpha)
+		return srgb ? FORMAT_BC3_UNORM_SRGB : FORMAT_BC3_UNORM;
+	return srgb ? FORMAT_BC1_UNORM_SRGB : FORMAT_BC1_UNORM;
+}
+
+bool CompressTexture(const TextureData& src, uint32_t format, TextureData& out)
+{
+	if (!CanGenerateMips(src.format))
+		return false;
+
+	void (*encode)(const uint8_t*, uint8_t*) = nullptr;
+	uint32_t blockBytes = 16;
+	switch (format)
+	{
+	case FORMAT_BC1_UNORM:
+	case FORMAT_BC1_UNORM_SRGB:
+		encode = EncodeBc1Block;
+		blockBytes = 8;
+		break;
+	case FORMAT_BC3_UNORM:
+	case FORMAT_BC3_UNORM_SRGB:
+		encode = EncodeBc3Block;
+		break;
+	case FORMAT_BC5_UNORM:
+		encode = EncodeBc5Block;
+		break;
+	default:
+		return false;
+	}
+
+	bool bgra = IsBgra(src.format);
+	bool opaque = src.format == FORMAT_B8G8R8X8_UNORM || src.format == FORMAT_B8G8R8X8_UNORM_SRGB;
+
+	out.width = src.width;
+	out.height = src.height;
+	out.format = format;
+	out.mips.resize(src.mips.size());
+	uint64_t total = 0;
+	for (size_t i = 0; i < src.mips.size(); i++)
+	{
+		TextureMip& mip = out.mips[i];
+		mip.offset = total;
+		mip.width = src.mips[i].width;
+		mip.height = src.mips[i].height;
+		mip.rowPitch = std::max(1u, (mip.width + 3) / 4) * blockBytes;
+		mip.rowCount = std::max(1u, (mip.height + 3) / 4);
+		total += static_cast<uint64_t>(mip.rowPitch) * mip.rowCount;
+	}
+	out.pixels.assign(total, 0);
+
+	uint8_t block[64];
+	for (size_t i = 0; i < src.mips.size(); i++)
+	{
+		const TextureMip& s = src.mips[i];
+		const TextureMip& d = out.mips[i];
+		for (uint32_t by = 0; by < d.rowCount; by++)
+		{
+			for (uint32_t bx = 0; bx * blockBytes < d.rowPitch; bx++)
+			{
+				//4x4 모으기, 밉 끝에 걸친 블록은 가장자리 픽셀을 반복
+				for (uint32_t py = 0; py < 4; py++)
+				{
+					uint32_t y = std::min(by * 4 + py, s.height - 1);
+					const uint8_t* row = &src.pixels[s.offset + y * s.rowPitch];
+					for (uint32_t px = 0; px < 4; px++)
+					{
+						uint32_t x = std::min(bx * 4 + px, s.width - 1);
+						uint8_t* p = block + (py * 4 + px) * 4;
+						p[0] = row[x * 4 + (bgra ? 2 : 0)];
+						p[1] = row[x * 4 + 1];
+						p[2] = row[x * 4 + (bgra ? 0 : 2)];
+						p[3] = opaque ? 255 : row[x * 4 + 3];
+					}
+				}
+				encode(block, &out.pixels[d.offset + by * d.rowPitch + bx * blockBytes]);
+			}
+		}
+	}
+	return true;
+}
+
+void SerializeDds(const TextureData& data, std::vector<uint8_t>& out)
+{
+	//DDS_HEADER + DDS_HEADER_DXT10 (DirectXTex DDS.h와 같은 배치)
+	uint32_t header[31 + 5] = {};
+	header[0] = 124; //크기
+	header[1] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; //CAPS HEIGHT WIDTH PIXELFORMAT MIPMAPCOUNT LINEARSIZE
+	header[2] = data.height;
+	header[3] = data.width;
+	header[4] = data.mips.empty() ? 0 : data.mips[0].rowPitch * data.mips[0].rowCount;
+	header[6] = static_cast<uint32_t>(data.mips.size());
+	header[18] = 32; //픽셀 포맷 크기
+	header[19] = 0x4; //FOURCC
+	header[20] = 0x30315844; //'DX10'
+	header[26] = 0x1000 | 0x8 | 0x400000; //TEXTURE COMPLEX MIPMAP
+	header[31] = data.format;
+	header[32] = 3; //TEXTURE2D
+	header[34] = 1; //배열 크기
+
+	out.clear();
+	out.insert(out.end(), { 'D', 'D', 'S', ' ' });
+	out.insert(out.end(), reinterpret_cast<const uint8_t*>(header), reinterpret_cast<const uint8_t*>(header) + sizeof(header));
+	for (const TextureMip& mip : data.mips)
+	{
+		const uint8_t* pixels = &data.pixels[mip.offset];
+		out.insert(out.end(), pixels, pixels + static_cast<size_t>(mip.rowPitch) * mip.rowCount);
+	}
+}
+
+bool SaveDds(const std::wstring& path, const TextureData& data)
+{
+	std::vector<uint8_t> bytes;
+	SerializeDds(data, bytes);
+
+	std::ofstream file(std::filesystem::path(path), std::ios::binary);
+	if (!file)
+		return false;
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(file);
+}
+
+//BC1 블록을 RGB로 풀어서 원본과 비교 (벤치마크 화질 확인용)
+static double Bc1Psnr(const TextureData& src, const TextureData& bc)
+{
+	const TextureMip& s = src.mips[0];
+	const TextureMip& d = bc.mips[0];
+	double sum = 0.0;
+	for (uint32_t y = 0; y < s.height; y++)
+	{
+		for (uint32_t x = 0; x < s.width; x++)
+		{
+			const uint8_t* block = &bc.pixels[d.offset + (y / 4) * d.rowPitch + (x / 4) * 8];
+			uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+			uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+			uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+			int index = (indices >> (2 * ((y % 4) * 4 + (x % 4)))) & 3;
+
+			int p0[3], p1[3], c[3];
+			UnpackRgb565(c0, p0);
+			UnpackRgb565(c1, p1);
+			for (int k = 0; k < 3; k++)
+			{
+				if (index == 0) c[k] = p0[k];
+				else if (index == 1) c[k] = p1[k];
+				else if (c0 > c1) c[k] = index == 2 ? (2 * p0[k] + p1[k]) / 3 : (p0[k] + 2 * p1[k]) / 3;
+				else c[k] = index == 2 ? (p0[k] + p1[k]) / 2 : 0;
+				double diff = static_cast<double>(c[k]) - src.pixels[s.offset + y * s.rowPitch + x * 4 + k];
+				sum += diff * diff;
+			}
+		}
+	}
+	double mse = sum / (3.0 * s.width * s.height);
+	return mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : 99.0;
+}
+
+void RunBcBenchmark(int size)
+{
+	size = std::max(4, size / 4 * 4);
+
+	//부드러운 그라디언트 + 잡음 (사진 텍스처 비슷하게)
+	TextureData source;
+	source.width = size;
+	source.height = size;
+	source.format = FORMAT_R8G8B8A8_UNORM;
+	source.mips.push_back({ 0, source.width, source.height, source.width * 4, source.height });
+	source.pixels.resize(static_cast<size_t>(size) * size * 4);
+	std::mt19937 rng(7);
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			uint8_t* p = &source.pixels[(static_cast<size_t>(y) * size + x) * 4];
+			int noise = static_cast<int>(rng() % 24) - 12;
+			p[0] = static_cast<uint8_t>(std::clamp(x * 255 / size + noise, 0, 255));
+			p[1] = static_cast<uint8_t>(std::clamp(y * 255 / size + noise, 0, 255));
+			p[2] = static_cast<uint8_t>(std::clamp(128 + static_cast<int>(60.0f * sinf(x * 0.05f) * cosf(y * 0.07f)) + noise, 0, 255));
+			p[3] = static_cast<uint8_t>((x ^ y) & 255);
+		}
+	}
+	GenerateMips(source);
+
+	printf("bc encode %dx%d (%zu levels)\n", size, size, source.mips.size());
+	const uint32_t formats[] = { FORMAT_BC1_UNORM, FORMAT_BC3_UNORM, FORMAT_BC5_UNORM };
+	const char* names[] = { "BC1", "BC3", "BC5" };
+	for (int f = 0; f < 3; f++)
+	{
+		TextureData out;
+		auto start = std::chrono::high_resolution_clock::now();
+		CompressTexture(source, formats[f], out);
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		double mpix = static_cast<double>(source.pixels.size() / 4) / (ms * 1000.0);
+		printf("  %s %.1f ms (%.1f Mpix/s), %zu -> %zu bytes (%.0fx)", names[f], ms, mpix, source.pixels.size(), out.pixels.size(), static_cast<double>(source.pixels.size()) / out.pixels.size());
+		if (formats[f] == FORMAT_BC1_UNORM)
+			printf(", PSNR %.2f dB", Bc1Psnr(source, out));
+		printf("\n");
+	}
+}
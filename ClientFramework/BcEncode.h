@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TextureStream.h"
+#include "MipGen.h"
+
+//블록 압축 인코더 (GPU 없이 동작)
+//4x4 블록마다 주성분 축으로 끝점을 잡고(BC1 색), 최소/최대로 끝점을 잡아(BC4 채널) 가장 가까운 인덱스를 고른다.
+//BC3 = BC4(알파) + BC1(색), BC5 = BC4(R) + BC4(G). BC7은 DirectXTex로 (Texture.cpp)
+
+constexpr uint32_t FORMAT_BC1_UNORM = 71;
+constexpr uint32_t FORMAT_BC1_UNORM_SRGB = 72;
+constexpr uint32_t FORMAT_BC3_UNORM = 77;
+constexpr uint32_t FORMAT_BC3_UNORM_SRGB = 78;
+constexpr uint32_t FORMAT_BC5_UNORM = 83;
+constexpr uint32_t FORMAT_BC7_UNORM = 98;
+constexpr uint32_t FORMAT_BC7_UNORM_SRGB = 99;
+
+//블록 하나 압축, rgba는 4x4 픽셀 RGBA 순서 (64바이트)
+void EncodeBc1Block(const uint8_t rgba[64], uint8_t out[8]);
+void EncodeBc3Block(const uint8_t rgba[64], uint8_t out[16]);
+void EncodeBc5Block(const uint8_t rgba[64], uint8_t out[16]);
+
+//8비트 RGBA 텍스처에 맞는 BC 포맷 (알파가 있으면 BC3, 노멀맵이면 BC5), 압축할 수 없으면 0
+//크기가 4의 배수가 아니면 D3D12가 BC 텍스처로 만들 수 없으므로 0
+uint32_t ChooseBcFormat(const TextureData& data, bool normalMap);
+
+//src(8비트 RGBA/BGRA, 밉 전부)를 format으로 압축해 out에 씀
+bool CompressTexture(const TextureData& src, uint32_t format, TextureData& out);
+
+//DX10 헤더 DDS 파일 내용 (밉은 TextureData 순서대로)
+void SerializeDds(const TextureData& data, std::vector<uint8_t>& out);
+bool SaveDds(const std::wstring& path, const TextureData& data);
+
+//CPU만 쓰는 압축 비용과 화질(PSNR) 측정, 결과는 콘솔로 출력
+void RunBcBenchmark(int size);
@@ -4,8 +4,8 @@
 class Camera
 {
 public:
-	XMFLOAT4X4 mProj = Identity4x4(); // ȯ 
+	XMFLOAT4X4 mProj = Identity4x4(); //투영 변환 행렬
 
-	// ȯ
+	//투영 변환
 	void TransformProjection(WindowInfo windowInfo);
 };
\ No newline at end of file
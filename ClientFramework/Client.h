@@ -7,12 +7,12 @@ bool isActive = true;
 class Client
 {
 public:
-	DxEngine dxEngine; //DX
-	WindowInfo windowInfo; //ȭ   ü
+	DxEngine dxEngine; //DX엔진
+	WindowInfo windowInfo; //화면 관련 정보 객체
 
 	void Init(HINSTANCE hInst, int nCmdShow)
 	{
-		// ü ʱȭ
+		//윈도우 객체 초기화
 		WNDCLASS WndClass;
 		WndClass.style = CS_HREDRAW | CS_VREDRAW;
 		WndClass.lpfnWndProc = WndProc;
@@ -32,23 +32,20 @@ public:
 		AllocConsole();
 		freopen("CONOUT$", "wt", stdout);
 
-		// ʱȭ
+		//엔진 초기화
 		dxEngine.Init(windowInfo);
 
-		//Ʈ  
-		vector<Vertex> vec;
-		vector<UINT> indexVec;
-		dxEngine.fbxLoaderPtr->LoadFbxData(vec, indexVec, "../Resources/AnimeCharacter.fbx");
-		dxEngine.vertexBufferPtr->CreateVertexBuffer(vec, dxEngine.devicePtr, 1);
-		dxEngine.indexBufferPtr->CreateIndexBuffer(indexVec, dxEngine.devicePtr, 1);
-		vector<Vertex> vec2;
-		vector<UINT> indexVec2;
-		dxEngine.fbxLoaderPtr->LoadFbxData(vec2, indexVec2, "../Resources/Dragon.fbx");
-		dxEngine.vertexBufferPtr->CreateVertexBuffer(vec2, dxEngine.devicePtr, 2);
-		dxEngine.indexBufferPtr->CreateIndexBuffer(indexVec2, dxEngine.devicePtr, 2);
+		//오브젝트 데이터 생성
+		dxEngine.BeginLoad();
+		MeshHandle playerMesh = dxEngine.LoadMesh("../Resources/AnimeCharacter.fbx");
+		MeshHandle npcMesh = dxEngine.LoadMesh("../Resources/Dragon.fbx");
+		dxEngine.EndLoad();
+		for (int i = 0; i < PLAYERMAX; i++)
+			dxEngine.playerArr[i].mesh = playerMesh;
+		for (int i = 0; i < NPCMAX; i++)
+			dxEngine.npcArr[i].mesh = npcMesh;
 		dxEngine.psoPtr->CreateInputLayoutAndPSOAndShader(dxEngine.devicePtr, dxEngine.rootSignaturePtr, dxEngine.dsvPtr);
-		dxEngine.texturePtr->CreateTexture(L"..\\Resources\\Texture\\bricks.dds", dxEngine.devicePtr, dxEngine.cmdQueuePtr);
-		dxEngine.texturePtr->CreateSRV(dxEngine.devicePtr);
+		dxEngine.texturePtr = dxEngine.textureStreamerPtr->RequestTexture(L"..\\Resources\\Texture\\bricks.dds"); //올라갈 때까지 플레이스홀더로 그림
 
 		dxEngine.cmdQueuePtr->WaitSync();
 	}
@@ -7,13 +7,24 @@ void CmdQueue::CreateCmdListAndCmdQueue(shared_ptr<Device> devicePtr)
 	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
 	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
 
-	devicePtr->_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&_cmdQueue)); //Ŀǵ ť 
-	devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_cmdAlloc)); //Ŀǵ Ҵ 
-	devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _cmdAlloc.Get(), nullptr, IID_PPV_ARGS(&_cmdList)); //Ŀǵ Ʈ 
+	devicePtr->_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&_cmdQueue)); //커맨드 큐 생성
+	for (int i = 0; i < FRAME_COUNT; i++)
+		devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_cmdAlloc[i])); //커맨드 할당자 생성
+	devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _cmdAlloc[0].Get(), nullptr, IID_PPV_ARGS(&_cmdList)); //커맨드 리스트 생성
 	_cmdList->Close();
 
-	devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_resCmdAlloc)); //ҽ Ŀǵ Ҵ 
-	devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _resCmdAlloc.Get(), nullptr, IID_PPV_ARGS(&_resCmdList)); //ҽ Ŀǵ Ʈ 
+	for (int i = 0; i < RECORD_THREAD_COUNT; i++)
+	{
+		for (int f = 0; f < FRAME_COUNT; f++)
+			devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_recordCmdAlloc[f][i])); //기록 스레드용 할당자
+		devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _recordCmdAlloc[0][i].Get(), nullptr, IID_PPV_ARGS(&_recordCmdList[i]));
+		_recordCmdList[i]->Close();
+	}
+
+	for (int f = 0; f < FRAME_COUNT; f++)
+		devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&_postCmdAlloc[f]));
+	devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, _postCmdAlloc[0].Get(), nullptr, IID_PPV_ARGS(&_postCmdList));
+	_postCmdList->Close();
 
 	devicePtr->_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
 	_fenceEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
@@ -21,26 +32,51 @@ void CmdQueue::CreateCmdListAndCmdQueue(shared_ptr<Device> devicePtr)
 
 void CmdQueue::WaitSync()
 {
-	_fenceValue++;
-	_cmdQueue->Signal(_fence.Get(), _fenceValue);
+	WaitFor(Signal());
+}
 
-	if (_fence->GetCompletedValue() < _fenceValue)
-	{
-		_fence->SetEventOnCompletion(_fenceValue, _fenceEvent);
+void CmdQueue::BeginFrame()
+{
+	_frameRing.BeginFrame(*this);
 
-		::WaitForSingleObject(_fenceEvent, INFINITE);
-	}
+	UINT frameIndex = _frameRing._frameIndex;
+	_cmdAlloc[frameIndex]->Reset();
+	_cmdList->Reset(_cmdAlloc[frameIndex].Get(), nullptr);
+	_postCmdAlloc[frameIndex]->Reset();
+	_postCmdList->Reset(_postCmdAlloc[frameIndex].Get(), nullptr);
 }
 
-void CmdQueue::FlushResourceCommandQueue()
+ID3D12GraphicsCommandList* CmdQueue::BeginRecordList(int thread)
 {
-	_resCmdList->Close();
+	UINT frameIndex = _frameRing._frameIndex;
+	_recordCmdAlloc[frameIndex][thread]->Reset();
+	_recordCmdList[thread]->Reset(_recordCmdAlloc[frameIndex][thread].Get(), nullptr);
+	return _recordCmdList[thread].Get();
+}
 
-	ID3D12CommandList* cmdListArr[] = { _resCmdList.Get() };
-	_cmdQueue->ExecuteCommandLists(_countof(cmdListArr), cmdListArr);
+void CmdQueue::EndFrame()
+{
+	_frameRing.EndFrame(*this);
+}
 
-	WaitSync();
+UINT64 CmdQueue::Signal()
+{
+	_fenceValue++;
+	_cmdQueue->Signal(_fence.Get(), _fenceValue);
+	return _fenceValue;
+}
+
+UINT64 CmdQueue::CompletedValue()
+{
+	return _fence->GetCompletedValue();
+}
+
+void CmdQueue::WaitFor(UINT64 value)
+{
+	if (_fence->GetCompletedValue() < value)
+	{
+		_fence->SetEventOnCompletion(value, _fenceEvent);
 
-	_resCmdAlloc->Reset();
-	_resCmdList->Reset(_resCmdAlloc.Get(), nullptr);
+		::WaitForSingleObject(_fenceEvent, INFINITE);
+	}
 }
\ No newline at end of file
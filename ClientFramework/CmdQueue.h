@@ -1,22 +1,38 @@
 #pragma once
 #include "Util.h"
+#include "FrameRing.h"
 class CmdQueue
 {
 public:
 	ComPtr<ID3D12CommandQueue>			_cmdQueue;
-	ComPtr<ID3D12CommandAllocator>		_cmdAlloc;
-	ComPtr<ID3D12GraphicsCommandList>	_cmdList;
-	ComPtr<ID3D12CommandAllocator>		_resCmdAlloc;
-	ComPtr<ID3D12GraphicsCommandList>	_resCmdList;
+	ComPtr<ID3D12CommandAllocator>		_cmdAlloc[FRAME_COUNT]; //프레임 슬롯별 할당자
+	ComPtr<ID3D12GraphicsCommandList>	_cmdList; //프레임 시작 (배리어, 클리어)
+	ComPtr<ID3D12CommandAllocator>		_recordCmdAlloc[FRAME_COUNT][RECORD_THREAD_COUNT];
+	ComPtr<ID3D12GraphicsCommandList>	_recordCmdList[RECORD_THREAD_COUNT]; //기록 스레드별 그리기
+	ComPtr<ID3D12CommandAllocator>		_postCmdAlloc[FRAME_COUNT];
+	ComPtr<ID3D12GraphicsCommandList>	_postCmdList; //프레임 끝 (present 배리어)
 
 	ComPtr<ID3D12Fence>					_fence;
-	UINT								_fenceValue = 0;
+	UINT64								_fenceValue = 0;
 	HANDLE								_fenceEvent = INVALID_HANDLE_VALUE;
 
-	//Ŀǵ Ʈ, ť, Ҵ 
+	FrameRing<CmdQueue, FRAME_COUNT>	_frameRing;
+
+	//커맨드 리스트, 큐, 할당자 생성
 	void CreateCmdListAndCmdQueue(shared_ptr<Device> devicePtr);
-	//cpu gpu ȭ
+	//cpu와 gpu 동기화 (큐 전체를 비움, 초기화/종료 때만)
 	void WaitSync();
-	//ҽ Ŀǵť  cpu gpu ȭ
-	void FlushResourceCommandQueue();
+
+	//프레임 시작, 현재 슬롯이 비면 그 슬롯의 할당자로 커맨드 리스트 리셋
+	void BeginFrame();
+	//프레임 제출 후 펜스 기록, 기다리지 않음
+	void EndFrame();
+	UINT GetFrameIndex() { return _frameRing._frameIndex; }
+	//기록 스레드 하나가 이번 프레임에 쓸 커맨드 리스트 리셋, 스레드마다 자기 번호만 사용
+	ID3D12GraphicsCommandList* BeginRecordList(int thread);
+
+	//FrameRing이 쓰는 펜스 함수
+	UINT64 Signal();
+	UINT64 CompletedValue();
+	void WaitFor(UINT64 value);
 };
\ No newline at end of file
@@ -1,57 +1,68 @@
 #include "Device.h"
 #include "ConstantBuffer.h"
-void ConstantBuffer::CreateConstantBuffer(UINT size, UINT count, shared_ptr<Device> devicePtr)
-{
-	_elementSize = (size + 255) & ~255;
-	_elementCount = count;
-
-	UINT bufferSize = _elementSize * _elementCount;
-	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
 
-	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&_cbvBuffer));
+void ConstantBuffer::CreateConstantBuffer(UINT pageSize, shared_ptr<Device> devicePtr)
+{
+	_pageSize = (pageSize + 255) & ~255;
 
-	_cbvBuffer->Map(0, nullptr, reinterpret_cast<void**>(&_mappedBuffer));
+	for (int i = 0; i < FRAME_COUNT; i++)
+	{
+		_frameIndex = i;
+		AddPage(_pageSize, devicePtr);
+	}
+	_frameIndex = 0;
 }
 
-void ConstantBuffer::CreateView(shared_ptr<Device> devicePtr)
+void ConstantBuffer::BeginFrame(UINT frameIndex)
 {
-	D3D12_DESCRIPTOR_HEAP_DESC cbvDesc = {};
-	cbvDesc.NumDescriptors = _elementCount;
-	cbvDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	cbvDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	devicePtr->_device->CreateDescriptorHeap(&cbvDesc, IID_PPV_ARGS(&_cbvHeap));
+	_frameIndex = frameIndex;
+	_currentPage = 0;
+	_currentOffset = 0;
+}
 
-	_cpuHandleBegin = _cbvHeap->GetCPUDescriptorHandleForHeapStart();
-	_handleIncrementSize = devicePtr->_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+UploadAllocation ConstantBuffer::Allocate(UINT size, shared_ptr<Device> devicePtr)
+{
+	UINT alignedSize = (size + 255) & ~255; //CBV는 256바이트 정렬
+	vector<Page>& pages = _pages[_frameIndex];
 
-	for (UINT i = 0; i < _elementCount; ++i)
+	//현재 페이지에 안 들어가면 다음 페이지로, 없으면 새로 만듦
+	while (_currentOffset + alignedSize > pages[_currentPage].size)
 	{
-		D3D12_CPU_DESCRIPTOR_HANDLE cbvHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(_cpuHandleBegin, i * _handleIncrementSize);
+		_currentPage++;
+		_currentOffset = 0;
+		if (_currentPage == pages.size())
+			AddPage(max(_pageSize, alignedSize), devicePtr);
+	}
 
-		D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-		cbvDesc.BufferLocation = _cbvBuffer->GetGPUVirtualAddress() + static_cast<UINT>(_elementSize) * i;
-		cbvDesc.SizeInBytes = _elementSize;   // CB size is required to be 256-byte aligned.
+	Page& page = pages[_currentPage];
+	UploadAllocation allocation;
+	allocation.cpuAddress = page.mappedBuffer + _currentOffset;
+	allocation.gpuAddress = page.buffer->GetGPUVirtualAddress() + _currentOffset;
+	allocation.size = alignedSize;
+	allocation.resource = page.buffer.Get();
+	allocation.offset = _currentOffset;
+	_currentOffset += alignedSize;
+	return allocation;
+}
 
-		devicePtr->_device->CreateConstantBufferView(&cbvDesc, cbvHandle);
-	}
+UploadAllocation ConstantBuffer::PushData(const void* buffer, UINT size, shared_ptr<Device> devicePtr)
+{
+	UploadAllocation allocation = Allocate(size, devicePtr);
+	memcpy(allocation.cpuAddress, buffer, size);
+	return allocation;
 }
 
-D3D12_CPU_DESCRIPTOR_HANDLE ConstantBuffer::PushData(int rootParamIndex, void* buffer, UINT size)
+void ConstantBuffer::AddPage(UINT size, shared_ptr<Device> devicePtr)
 {
-	assert(_currentIndex < _elementSize);
+	Page page;
+	page.size = size;
 
-	memcpy(&_mappedBuffer[_currentIndex * _elementSize], buffer, size);
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(size);
 
-	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(_cpuHandleBegin, _currentIndex * _handleIncrementSize);
-	_currentIndex++;
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&page.buffer));
 
-	return cpuHandle;
-}
+	page.buffer->Map(0, nullptr, reinterpret_cast<void**>(&page.mappedBuffer));
 
-D3D12_GPU_VIRTUAL_ADDRESS ConstantBuffer::GetGpuVirtualAddress(UINT index)
-{
-	D3D12_GPU_VIRTUAL_ADDRESS objCBAddress = _cbvBuffer->GetGPUVirtualAddress();
-	objCBAddress += index * _elementSize;
-	return objCBAddress;
-}
\ No newline at end of file
+	_pages[_frameIndex].push_back(page);
+}
@@ -1,25 +1,46 @@
 #pragma once
 #include "Util.h"
+
+//업로드 힙에서 잘라준 영역
+struct UploadAllocation
+{
+	BYTE* cpuAddress = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+	UINT size = 0;
+	ID3D12Resource* resource = nullptr; //복사 원본으로 쓸 때 (CopyBufferRegion)
+	UINT64 offset = 0;
+};
+
+//프레임별 선형 업로드 할당자
+//프레임 슬롯마다 페이지 목록을 가지고 앞에서부터 256바이트 단위로 잘라 쓴다.
+//페이지가 다 차면 새 페이지를 추가하고, 슬롯을 다시 쓸 때(BeginFrame) 처음부터 다시 쓴다.
+//Allocate는 메인 스레드에서만 부르고, 받은 영역을 채우는 것은 어느 스레드든 상관없음
 class ConstantBuffer
 {
 public:
-	ComPtr<ID3D12Resource>	_cbvBuffer;
-	BYTE* _mappedBuffer = nullptr;
-	UINT _elementSize = 0;
-	UINT _elementCount = 0;
+	struct Page
+	{
+		ComPtr<ID3D12Resource> buffer;
+		BYTE* mappedBuffer = nullptr;
+		UINT size = 0;
+	};
 
-	UINT _currentIndex = 0;
+	vector<Page> _pages[FRAME_COUNT];
+	UINT _pageSize = 0;
 
-	ComPtr<ID3D12DescriptorHeap> _cbvHeap;
-	D3D12_CPU_DESCRIPTOR_HANDLE	 _cpuHandleBegin = {};
-	UINT _handleIncrementSize = 0;
+	UINT _frameIndex = 0;
+	UINT _currentPage = 0;
+	UINT _currentOffset = 0;
 
-	//  
-	void CreateConstantBuffer(UINT size, UINT count, shared_ptr<Device> devicePtr);
-	//CBV 
-	void CreateView(shared_ptr<Device> devicePtr);
-	// ۿ  
-	D3D12_CPU_DESCRIPTOR_HANDLE PushData(int rootParamIndex, void* buffer, UINT size);
+	//페이지 크기 설정, 프레임 슬롯마다 첫 페이지 생성
+	void CreateConstantBuffer(UINT pageSize, shared_ptr<Device> devicePtr);
+	//프레임 시작, 이 프레임 슬롯의 페이지를 처음부터 사용
+	void BeginFrame(UINT frameIndex);
+	//size바이트 (256 단위로 올림) 잘라서 반환
+	UploadAllocation Allocate(UINT size, shared_ptr<Device> devicePtr);
+	//잘라서 데이터 복사까지
+	UploadAllocation PushData(const void* buffer, UINT size, shared_ptr<Device> devicePtr);
 
-	D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAddress(UINT index);
-};
\ No newline at end of file
+private:
+	void AddPage(UINT size, shared_ptr<Device> devicePtr);
+};
@@ -0,0 +1,167 @@
+#include "Device.h"
+#include "CmdQueue.h"
+#include "CopyQueue.h"
+
+void CopyQueue::CreateCopyQueue(UINT64 stagingSize, shared_ptr<Device> devicePtr)
+{
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+	devicePtr->_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&_copyQueue));
+	devicePtr->_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&_copyCmdAlloc));
+	devicePtr->_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, _copyCmdAlloc.Get(), nullptr, IID_PPV_ARGS(&_copyCmdList));
+	_copyCmdList->Close();
+
+	devicePtr->_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+	_fenceEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(stagingSize);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&_stagingBuffer));
+
+	CD3DX12_RANGE readRange(0, 0);
+	_stagingBuffer->Map(0, &readRange, reinterpret_cast<void**>(&_mappedStaging));
+	_stagingRing.Init(stagingSize);
+}
+
+void CopyQueue::BeginBatch()
+{
+	//할당자를 다시 쓰려면 이전 배치가 끝나 있어야 함
+	WaitFor(_fenceValue);
+	_stagingRing.Retire(_fenceValue);
+	_oversizedBuffers.clear();
+
+	_copyCmdAlloc->Reset();
+	_copyCmdList->Reset(_copyCmdAlloc.Get(), nullptr);
+	_batchOpen = true;
+}
+
+void CopyQueue::UploadBuffer(ID3D12Resource* dest, UINT64 destOffset, const void* data, UINT64 size, shared_ptr<Device> devicePtr)
+{
+	assert(_batchOpen);
+	if (size == 0)
+		return;
+
+	//링보다 크면 이 업로드만 임시 버퍼로
+	if (size > _stagingRing.GetCapacity())
+	{
+		BYTE* mapped = CreateOversizedBuffer(size, devicePtr);
+		memcpy(mapped, data, size);
+		_copyCmdList->CopyBufferRegion(dest, destOffset, _oversizedBuffers.back().Get(), 0, size);
+		return;
+	}
+
+	UINT64 offset = _stagingRing.Allocate(size, 4);
+	if (offset == StagingRing::INVALID_OFFSET)
+	{
+		//링이 가득 참, 지금까지 기록한 것을 제출하고 끝날 때까지 기다린 뒤 이어서 기록
+		WaitFor(Submit());
+		_stagingRing.Retire(_fenceValue);
+		_copyCmdAlloc->Reset();
+		_copyCmdList->Reset(_copyCmdAlloc.Get(), nullptr);
+		offset = _stagingRing.Allocate(size, 4);
+	}
+
+	memcpy(_mappedStaging + offset, data, size);
+	_copyCmdList->CopyBufferRegion(dest, destOffset, _stagingBuffer.Get(), offset, size);
+}
+
+bool CopyQueue::UploadTexture(ID3D12Resource* dest, const TextureData& data, shared_ptr<Device> devicePtr)
+{
+	assert(_batchOpen);
+
+	D3D12_RESOURCE_DESC desc = dest->GetDesc();
+	UINT subresourceCount = static_cast<UINT>(data.mips.size());
+	vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresourceCount);
+	vector<UINT> rowCounts(subresourceCount);
+	vector<UINT64> rowSizes(subresourceCount);
+	UINT64 totalSize = 0;
+	devicePtr->_device->GetCopyableFootprints(&desc, 0, subresourceCount, 0, layouts.data(), rowCounts.data(), rowSizes.data(), &totalSize);
+
+	ID3D12Resource* source = nullptr;
+	BYTE* mapped = nullptr;
+	UINT64 baseOffset = 0;
+	if (totalSize > _stagingRing.GetCapacity())
+	{
+		mapped = CreateOversizedBuffer(totalSize, devicePtr);
+		source = _oversizedBuffers.back().Get();
+	}
+	else
+	{
+		baseOffset = _stagingRing.Allocate(totalSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+		if (baseOffset == StagingRing::INVALID_OFFSET)
+			return false;
+		mapped = _mappedStaging + baseOffset;
+		source = _stagingBuffer.Get();
+	}
+
+	for (UINT i = 0; i < subresourceCount; i++)
+	{
+		//디코드된 행 간격 -> 256바이트 정렬된 footprint 행 간격
+		const TextureMip& mip = data.mips[i];
+		for (UINT row = 0; row < rowCounts[i]; row++)
+			memcpy(mapped + layouts[i].Offset + row * layouts[i].Footprint.RowPitch, data.pixels.data() + mip.offset + row * mip.rowPitch, static_cast<size_t>(rowSizes[i]));
+
+		D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = layouts[i];
+		layout.Offset += baseOffset;
+		CD3DX12_TEXTURE_COPY_LOCATION dst(dest, i);
+		CD3DX12_TEXTURE_COPY_LOCATION src(source, layout);
+		_copyCmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+	}
+	return true;
+}
+
+UINT64 CopyQueue::EndBatch(shared_ptr<CmdQueue> cmdQueuePtr)
+{
+	assert(_batchOpen);
+	_batchOpen = false;
+
+	UINT64 fenceValue = Submit();
+	if (cmdQueuePtr)
+		cmdQueuePtr->_cmdQueue->Wait(_fence.Get(), fenceValue); //그리기 큐는 복사가 끝난 뒤에 실행
+	return fenceValue;
+}
+
+UINT64 CopyQueue::Submit()
+{
+	_copyCmdList->Close();
+
+	ID3D12CommandList* cmdListArr[] = { _copyCmdList.Get() };
+	_copyQueue->ExecuteCommandLists(_countof(cmdListArr), cmdListArr);
+
+	_fenceValue++;
+	_copyQueue->Signal(_fence.Get(), _fenceValue);
+	_stagingRing.Commit(_fenceValue);
+	return _fenceValue;
+}
+
+BYTE* CopyQueue::CreateOversizedBuffer(UINT64 size, shared_ptr<Device> devicePtr)
+{
+	ComPtr<ID3D12Resource> buffer;
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+
+	//업로드 힙은 매핑한 채로 해제해도 됨
+	BYTE* mapped = nullptr;
+	CD3DX12_RANGE readRange(0, 0);
+	buffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped));
+	_oversizedBuffers.push_back(buffer);
+	return mapped;
+}
+
+UINT64 CopyQueue::CompletedValue()
+{
+	return _fence->GetCompletedValue();
+}
+
+void CopyQueue::WaitFor(UINT64 value)
+{
+	if (_fence->GetCompletedValue() < value)
+	{
+		_fence->SetEventOnCompletion(value, _fenceEvent);
+
+		::WaitForSingleObject(_fenceEvent, INFINITE);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Util.h"
+#include "StagingRing.h"
+#include "TextureStream.h"
+
+//복사 전용 큐
+//로드 한 번(배치)에 필요한 업로드를 스테이징 링에 모아 커맨드 리스트 하나에 기록하고,
+//배치 끝에 한 번만 제출하고 펜스를 건다. 그리기 큐는 CPU가 아니라 GPU에서 그 펜스를 기다린다.
+//
+//	copyQueuePtr->BeginBatch();
+//	... UploadBuffer(...) 여러 번 ...
+//	copyQueuePtr->EndBatch(cmdQueuePtr);
+class CopyQueue
+{
+public:
+	ComPtr<ID3D12CommandQueue>			_copyQueue;
+	ComPtr<ID3D12CommandAllocator>		_copyCmdAlloc;
+	ComPtr<ID3D12GraphicsCommandList>	_copyCmdList;
+
+	ComPtr<ID3D12Fence>					_fence;
+	UINT64								_fenceValue = 0;
+	HANDLE								_fenceEvent = INVALID_HANDLE_VALUE;
+
+	ComPtr<ID3D12Resource>				_stagingBuffer; //업로드 힙, 계속 매핑해 둠
+	BYTE*								_mappedStaging = nullptr;
+	StagingRing							_stagingRing;
+
+	vector<ComPtr<ID3D12Resource>>		_oversizedBuffers; //링보다 큰 업로드용 임시 버퍼, 배치가 끝나면 해제
+	bool								_batchOpen = false;
+
+	//큐, 커맨드 리스트, 펜스, 스테이징 버퍼 생성
+	void CreateCopyQueue(UINT64 stagingSize, shared_ptr<Device> devicePtr);
+
+	//배치 시작, 커맨드 리스트 리셋
+	void BeginBatch();
+	//data를 스테이징에 복사하고 dest의 destOffset 위치로 복사 명령 기록
+	//dest는 기본 힙 버퍼 (COMMON 상태, 복사 큐에서 자동으로 COPY_DEST로 바뀜)
+	void UploadBuffer(ID3D12Resource* dest, UINT64 destOffset, const void* data, UINT64 size, shared_ptr<Device> devicePtr);
+	//data의 밉들을 dest의 서브리소스로 복사 기록 (행 간격은 복사 가능한 footprint에 맞춰 다시 잡음)
+	//링에 자리가 없으면 기다리지 않고 false
+	bool UploadTexture(ID3D12Resource* dest, const TextureData& data, shared_ptr<Device> devicePtr);
+	//배치 제출, 펜스 한 번. cmdQueuePtr를 주면 그리기 큐가 이 펜스를 GPU에서 기다리게 함. 펜스 값 반환
+	UINT64 EndBatch(shared_ptr<CmdQueue> cmdQueuePtr);
+
+	UINT64 CompletedValue();
+	void WaitFor(UINT64 value);
+
+private:
+	//기록한 것까지 제출하고 펜스 값 반환 (링이 가득 찼을 때는 배치 중간에도 씀)
+	UINT64 Submit();
+	//링보다 큰 업로드용 임시 버퍼 생성, 매핑한 주소 반환
+	BYTE* CreateOversizedBuffer(UINT64 size, shared_ptr<Device> devicePtr);
+};
@@ -8,6 +8,6 @@ public:
 	D3D12_CPU_DESCRIPTOR_HANDLE			_dsvHandle = {};
 	DXGI_FORMAT							_dsvFormat = {};
 	
-	//DSV
+	//DSV생성
 	void CreateDSV(DXGI_FORMAT dsvFormat, WindowInfo windowInfo, shared_ptr<Device> devicePtr);
 };
\ No newline at end of file
@@ -1,21 +1,23 @@
 #pragma once
 #include "Util.h"
+#include "DescriptorAllocator.h"
+//셰이더에 보이는 바인드리스 SRV 힙
+//텍스처마다 힙 안의 고정 번호를 하나 받아 거기에 SRV를 만들고, 셰이더는 상수로 받은 번호로 gTextures[]를 읽는다.
+//힙 전체를 테이블 하나로 커맨드 리스트마다 한 번만 바인딩
 class DescHeap
 {
 public:
 	ComPtr<ID3D12DescriptorHeap> _descHeap;
 	UINT _handleSize = 0;
-	UINT _groupSize = 0;
-	UINT _groupCount = 0;
-	UINT _currentGroupIndex = 0;
+	DescriptorAllocator _allocator;
 
 	void CreateDescTable(UINT count, shared_ptr<Device> devicePtr);
 
-	void SetCBV(D3D12_CPU_DESCRIPTOR_HANDLE srcHandle, UINT reg, shared_ptr<Device> devicePtr);
+	//번호 할당/반납, 지금은 텍스처 번호를 반납하지 않음 (Texture.h 참고)
+	UINT AllocateIndex();
+	void FreeIndex(UINT index);
 
-	void SetSRV(D3D12_CPU_DESCRIPTOR_HANDLE srcHandle, UINT reg, shared_ptr<Device> devicePtr);
+	void CommitTable(ID3D12GraphicsCommandList* cmdList);
 
-	void CommitTable(shared_ptr<CmdQueue> cmdQueuePtr);
-
-	D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(UINT reg);
-};
\ No newline at end of file
+	D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(UINT index);
+};
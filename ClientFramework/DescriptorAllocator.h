@@ -0,0 +1,79 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+//디스크립터 힙 번호 할당자 (GPU 없이 동작)
+//한 번 받은 번호는 Free할 때까지 바뀌지 않으므로 셰이더에 그대로 넘길 수 있다.
+//반납된 번호를 먼저 다시 쓰고, 없으면 아직 안 쓴 번호를 앞에서부터 준다.
+//디버그 빌드는 번호마다 사용 중인지 기록해 두 번 반납, 범위 밖 반납을 잡는다.
+class DescriptorAllocator
+{
+public:
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+	void Init(uint32_t capacity)
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		_capacity = capacity;
+		_nextIndex = 0;
+		_freeList.clear();
+#ifndef NDEBUG
+		_allocated.assign(capacity, false);
+#endif
+	}
+
+	//빈 번호 하나, 가득 찼으면 INVALID_INDEX
+	uint32_t Allocate()
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		uint32_t index = INVALID_INDEX;
+		if (!_freeList.empty())
+		{
+			index = _freeList.back();
+			_freeList.pop_back();
+		}
+		else if (_nextIndex < _capacity)
+		{
+			index = _nextIndex++;
+		}
+#ifndef NDEBUG
+		if (index != INVALID_INDEX)
+			_allocated[index] = true;
+#endif
+		return index;
+	}
+
+	//두 번 반납하면 같은 번호가 두 텍스처에 나가므로 디버그 빌드에서 assert
+	void Free(uint32_t index)
+	{
+		if (index == INVALID_INDEX)
+			return;
+		std::lock_guard<std::mutex> guard(_lock);
+		assert(index < _nextIndex && "freeing an index that was never allocated");
+#ifndef NDEBUG
+		assert(_allocated[index] && "double free of a descriptor index");
+		_allocated[index] = false;
+#endif
+		_freeList.push_back(index);
+	}
+
+	//지금 쓰고 있는 번호 수
+	uint32_t GetUsedCount()
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		return _nextIndex - static_cast<uint32_t>(_freeList.size());
+	}
+
+	uint32_t GetCapacity() const { return _capacity; }
+
+private:
+	std::mutex				_lock;
+	uint32_t				_capacity = 0;
+	uint32_t				_nextIndex = 0; //한 번도 준 적 없는 첫 번호
+	std::vector<uint32_t>	_freeList;
+#ifndef NDEBUG
+	std::vector<bool>		_allocated; //번호 -> 지금 누가 쓰고 있는지
+#endif
+};
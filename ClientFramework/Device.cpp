@@ -2,6 +2,6 @@
 
 void Device::CreateDevice()
 {
-	CreateDXGIFactory(IID_PPV_ARGS(&_dxgi)); //DXGI 
-	D3D12CreateDevice(nullptr, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&_device)); //̽ 
+	CreateDXGIFactory(IID_PPV_ARGS(&_dxgi)); //DXGI 생성
+	D3D12CreateDevice(nullptr, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&_device)); //디바이스 생성
 }
\ No newline at end of file
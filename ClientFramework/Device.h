@@ -6,6 +6,6 @@ public:
 	ComPtr<IDXGIFactory>		_dxgi;
 	ComPtr<ID3D12Device>		_device;
 
-	//̽ 
+	//디바이스 생성
 	void CreateDevice();
 };
\ No newline at end of file
@@ -1,25 +1,46 @@
 #include "DxEngine.h"
 #include "Device.h"
 
+DxEngine::~DxEngine()
+{
+	//GPU가 아직 쓰고 있는 리소스를 해제하지 않도록 모든 프레임이 끝날 때까지 대기
+	if (cmdQueuePtr->_cmdQueue)
+		cmdQueuePtr->_frameRing.WaitIdle(*cmdQueuePtr);
+	if (copyQueuePtr->_copyQueue)
+		copyQueuePtr->WaitFor(copyQueuePtr->_fenceValue);
+}
+
 void DxEngine::Init(WindowInfo windowInfo)
 {
-	//Ž
-	networkPtr->ConnectServer(); // 
+	//통신시작
+	networkPtr->ConnectServer(); //데이터 보냄
 
-	//ȭ ũ 
+	//화면 크기 설정
 	_viewport = { 0, 0, static_cast<FLOAT>(windowInfo.ClientWidth), static_cast<FLOAT>(windowInfo.ClientHeight), 0.0f, 1.0f };
 	_scissorRect = CD3DX12_RECT(0, 0, windowInfo.ClientWidth, windowInfo.ClientHeight);
 
-	//DX ʱȭ
+	//DX엔진 초기화
 	devicePtr->CreateDevice();
 	cmdQueuePtr->CreateCmdListAndCmdQueue(devicePtr);
+	copyQueuePtr->CreateCopyQueue(STAGING_BUFFER_SIZE, devicePtr);
 	swapChainPtr->DescriptAndCreateSwapChain(windowInfo, devicePtr, cmdQueuePtr);
 	rtvPtr->CreateRTV(devicePtr, swapChainPtr);
-	cameraPtr->TransformProjection(windowInfo); // ȯ
+	cameraPtr->TransformProjection(windowInfo); //투영 변환
 	rootSignaturePtr->CreateRootSignature(devicePtr);
-	constantBufferPtr->CreateConstantBuffer(sizeof(Constants), 256, devicePtr);
-	constantBufferPtr->CreateView(devicePtr);
-	descHeapPtr->CreateDescTable(256, devicePtr);
+	constantBufferPtr->CreateConstantBuffer(64 * 1024, devicePtr);
+	descHeapPtr->CreateDescTable(BINDLESS_SRV_COUNT, devicePtr);
+	if (!assetPackPtr->Open(ASSET_PACK_PATH)) //없으면 낱개 파일에서 읽음
+		printf("asset pack: %s not found, loading loose files\n", ASSET_PACK_PATH);
+	textureStreamerPtr->CreateTextureStreamer(TEXTURE_DECODE_THREAD_COUNT, devicePtr, copyQueuePtr, descHeapPtr, assetPackPtr);
+	instanceBufferPtr->CreateInstanceBuffer(PLAYERMAX + NPCMAX, devicePtr);
+	vertexBufferPtr->CreateVertexBuffer(MESH_VERTEX_CAPACITY, devicePtr);
+	indexBufferPtr->CreateIndexBuffer(sizeof(uint16_t), MESH_INDEX_CAPACITY, devicePtr);
+	indexBuffer32Ptr->CreateIndexBuffer(sizeof(UINT), MESH_INDEX32_CAPACITY, devicePtr);
+#if GPU_CULLING
+	//플레이어와 NPC가 같은 메쉬 LOD에 모두 몰릴 수 있으므로 칸은 전체 인스턴스 수만큼
+	//오브젝트 칸은 playerArr, npcArr 순서
+	gpuCullingPtr->CreateGpuCulling(MAX_MESH_COUNT, MESH_LOD_COUNT, PLAYERMAX + NPCMAX, PLAYERMAX + NPCMAX, devicePtr, rootSignaturePtr);
+#endif
 	timerPtr->InitTimer();
 	dsvPtr->CreateDSV(DXGI_FORMAT_D32_FLOAT, windowInfo, devicePtr);
 	RECT rect = { 0, 0, windowInfo.ClientWidth, windowInfo.ClientHeight };
@@ -27,7 +48,10 @@ void DxEngine::Init(WindowInfo windowInfo)
 	SetWindowPos(windowInfo.hwnd, 0, 100, 100, windowInfo.ClientWidth, windowInfo.ClientHeight, 0);
 	dsvPtr->CreateDSV(DXGI_FORMAT_D32_FLOAT, windowInfo, devicePtr);
 
-	inputPtr->Init(); //  ʱȭ
+	renderThreadsPtr->Init(RECORD_THREAD_COUNT - 1); //메인 스레드도 기록하므로 하나 적게
+	_drawItems.reserve(2 * MESH_LOD_COUNT);
+
+	inputPtr->Init(); //벡터 사이즈 초기화
 	for (int i = 0; i < PLAYERMAX; i++)
 	{
 		playerArr[i].transform = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
@@ -35,6 +59,7 @@ void DxEngine::Init(WindowInfo windowInfo)
 	for (int i = 0; i < NPCMAX; i++)
 	{
 		npcArr[i].transform = XMFLOAT4(5.0f * (i - NPCMAX / 2), 0.0f, 20.0f, 0.0f);
+		npcArr[i].scale = 0.2f;
 	}
 }
 
@@ -42,22 +67,41 @@ void DxEngine::Update(WindowInfo windowInfo, bool isActive)
 {
 	networkPtr->ReceiveServer(playerArr, npcArr);
 
-	timerPtr->TimerUpdate(); //Ÿ̸ Ʈ
-	timerPtr->ShowFps(windowInfo); //fps
+	timerPtr->TimerUpdate(); //타이머 업데이트
+	textureStreamerPtr->Update(descHeapPtr); //다 올라간 텍스처 SRV 교체
+	timerPtr->ShowFps(windowInfo); //fps출력
 	if (isActive)
 	{
-		inputPtr->InputKey(timerPtr, playerArr, networkPtr);
+		if (inputPtr->InputKey(timerPtr, playerArr, networkPtr))
+			networkPtr->changedPlayers.push_back(networkPtr->myClientId);
+	}
+
+#if GPU_CULLING
+	//바뀐 오브젝트와 메쉬만 GPU 컬링 입력에 다시 씀
+	if (!_cullInstancesReady) //메쉬는 Init 뒤에 정해지므로 첫 프레임에 한 번 전부
+	{
+		for (int i = 0; i < PLAYERMAX + NPCMAX; i++)
+			UpdateCullInstance(i);
+		_cullInstancesReady = true;
 	}
+	for (int id : networkPtr->changedPlayers)
+		UpdateCullInstance(id);
+	if (meshRegistryPtr->GetMeshCount() != _cullMeshCount || texturePtr->_srvIndex != _cullTextureIndex)
+		UpdateCullMeshes();
+#endif
+	networkPtr->changedPlayers.clear();
 
-	//VP ȯ
+	//VP 변환
 	XMVECTOR pos = XMVectorSet(playerArr[networkPtr->myClientId].transform.x, 0.0f, playerArr[networkPtr->myClientId].transform.z - 10.0f, 1.0f);
 	XMVECTOR target = XMVectorSet(playerArr[networkPtr->myClientId].transform.x, playerArr[networkPtr->myClientId].transform.y, playerArr[networkPtr->myClientId].transform.z, playerArr[networkPtr->myClientId].transform.w);
 	XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-	XMMATRIX view = XMMatrixLookAtLH(pos, target, up); // ȯ 
+	XMMATRIX view = XMMatrixLookAtLH(pos, target, up); //뷰 변환 행렬
+	XMStoreFloat3(&_eyePosition, pos);
 	XMStoreFloat4x4(&vertexBufferPtr->_transform.view, XMMatrixTranspose(view));
 
-	XMMATRIX proj = XMLoadFloat4x4(&cameraPtr->mProj); // ȯ 
+	XMMATRIX proj = XMLoadFloat4x4(&cameraPtr->mProj); //투영 변환 행렬
 	XMStoreFloat4x4(&vertexBufferPtr->_transform.proj, XMMatrixTranspose(proj));
+	XMStoreFloat4x4(&_viewProj, view * proj); //컬링용 (전치 안 함)
 
 	//Light
 	LightInfo lightInfo;
@@ -66,98 +110,345 @@ void DxEngine::Update(WindowInfo windowInfo, bool isActive)
 
 void DxEngine::Draw()
 {
-	// 
-	cmdQueuePtr->_cmdAlloc->Reset();
-	cmdQueuePtr->_cmdList->Reset(cmdQueuePtr->_cmdAlloc.Get(), nullptr);
+	//렌더 시작, 이 프레임 슬롯을 GPU가 아직 쓰고 있으면 그것만 기다림
+	cmdQueuePtr->BeginFrame();
+	UINT frameIndex = cmdQueuePtr->GetFrameIndex();
+	constantBufferPtr->BeginFrame(frameIndex);
+	instanceBufferPtr->BeginFrame(frameIndex);
 
-	D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(swapChainPtr->_renderTargets[swapChainPtr->_backBufferIndex].Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	//뷰, 투영, 조명은 프레임마다 한 번만 올림
+	_frameCB = constantBufferPtr->PushData(&vertexBufferPtr->_transform, sizeof(vertexBufferPtr->_transform), devicePtr);
+
+#if !GPU_CULLING
+	//절두체 컬링, 플레이어와 npc의 월드 경계 구를 모아 4개씩 검사
+	_cullSpheres.Clear();
+	_cullObjects.clear();
+	for (int i = 0; i < PLAYERMAX; i++)
+	{
+		if (playerArr[i].on == true)
+			AddCullObject(playerArr[i]);
+	}
+	for (int i = 0; i < NPCMAX; i++)
+		AddCullObject(npcArr[i]);
 
-	cmdQueuePtr->_cmdList->SetGraphicsRootSignature(rootSignaturePtr->_signature.Get());
-	constantBufferPtr->_currentIndex = 0;
-	descHeapPtr->_currentGroupIndex = 0;
+	FrustumPlanes planes;
+	ExtractFrustumPlanes(&_viewProj.m[0][0], planes);
+	_visible.resize(_cullSpheres._count);
+	int visibleCount = CullSpheresSSE(planes, _cullSpheres, _visible.data());
 
-	ID3D12DescriptorHeap* descHeap = descHeapPtr->_descHeap.Get();
-	cmdQueuePtr->_cmdList->SetDescriptorHeaps(1, &descHeap);
+	//보이는 것만 화면 크기로 LOD 선택
+	for (int v = 0; v < visibleCount; v++)
+	{
+		uint32_t i = _visible[v];
+		float dx = _cullSpheres._x[i] - _eyePosition.x;
+		float dy = _cullSpheres._y[i] - _eyePosition.y;
+		float dz = _cullSpheres._z[i] - _eyePosition.z;
+		float screenSize = ScreenSize(_cullSpheres._r[i], sqrtf(dx * dx + dy * dy + dz * dz), cameraPtr->mProj._22);
+		_cullObjects[i].lod = SelectLod(screenSize, LOD_SCREEN_SIZE, MESH_LOD_COUNT);
+	}
 
-	cmdQueuePtr->_cmdList->ResourceBarrier(1, &barrier);
+	//보이는 오브젝트를 메쉬 LOD별로 모음 (계수 정렬)
+	UINT bucketCount = meshRegistryPtr->GetMeshCount() * MESH_LOD_COUNT;
+	_bucketStart.assign(bucketCount + 1, 0);
+	for (int v = 0; v < visibleCount; v++)
+	{
+		const CullObject& obj = _cullObjects[_visible[v]];
+		_bucketStart[obj.mesh * MESH_LOD_COUNT + obj.lod + 1]++;
+	}
+	for (UINT bucket = 0; bucket < bucketCount; bucket++)
+		_bucketStart[bucket + 1] += _bucketStart[bucket];
+	_sortedVisible.resize(visibleCount);
+	{
+		vector<UINT>& cursor = _bucketCursor;
+		cursor.assign(_bucketStart.begin(), _bucketStart.end() - 1);
+		for (int v = 0; v < visibleCount; v++)
+		{
+			const CullObject& obj = _cullObjects[_visible[v]];
+			_sortedVisible[cursor[obj.mesh * MESH_LOD_COUNT + obj.lod]++] = _visible[v];
+		}
+	}
 
-	cmdQueuePtr->_cmdList->RSSetViewports(1, &_viewport);
-	cmdQueuePtr->_cmdList->RSSetScissorRects(1, &_scissorRect);
+	//그릴 목록, 메쉬 LOD마다 하나 (보이는 인스턴스의 월드 행렬만 인스턴스 버퍼에 모아 씀)
+	//상수 버퍼 영역을 미리 정해 두어서 스레드끼리 겹치지 않음
+	_drawItems.clear();
+	for (UINT bucket = 0; bucket < bucketCount; bucket++)
+	{
+		if (_bucketStart[bucket] == _bucketStart[bucket + 1])
+			continue;
+
+		const Mesh& mesh = meshRegistryPtr->GetMesh(bucket / MESH_LOD_COUNT);
+		const MeshLod& lod = mesh.lods[bucket % MESH_LOD_COUNT];
+
+		DrawItem item;
+		item.indexCount = lod.indexCount;
+		item.startIndex = lod.firstIndex;
+		item.baseVertex = mesh.baseVertex;
+		item.mesh = bucket / MESH_LOD_COUNT;
+		item.textureIndex = texturePtr->_srvIndex;
+		item.instanceBase = instanceBufferPtr->_currentIndex;
+		for (UINT v = _bucketStart[bucket]; v < _bucketStart[bucket + 1]; v++)
+		{
+			const CullObject& obj = _cullObjects[_sortedVisible[v]];
+
+			//월드 변환
+			InstanceData instance;
+			XMMATRIX world = XMMatrixScaling(obj.scale, obj.scale, obj.scale) * XMMatrixTranslation(obj.position.x, obj.position.y, obj.position.z);
+			XMStoreFloat4x4(&instance.world, XMMatrixTranspose(world));
+			instanceBufferPtr->PushInstance(instance);
+			item.instanceCount++;
+		}
+		item.objectCB = constantBufferPtr->Allocate(sizeof(ObjectConstants), devicePtr);
+		_drawItems.push_back(item);
+	}
+#endif
+
+	//프레임 시작 커맨드 (배리어, 클리어)
+	ID3D12GraphicsCommandList* preCmdList = cmdQueuePtr->_cmdList.Get();
+	D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(swapChainPtr->_renderTargets[swapChainPtr->_backBufferIndex].Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	preCmdList->ResourceBarrier(1, &barrier);
 
 	D3D12_CPU_DESCRIPTOR_HANDLE backBufferView = rtvPtr->_rtvHandle[swapChainPtr->_backBufferIndex];
-	cmdQueuePtr->_cmdList->ClearRenderTargetView(backBufferView, Colors::LightSteelBlue, 0, nullptr);
-	D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = dsvPtr->_dsvHandle;
-	cmdQueuePtr->_cmdList->OMSetRenderTargets(1, &backBufferView, FALSE, &depthStencilView);
+	preCmdList->ClearRenderTargetView(backBufferView, Colors::LightSteelBlue, 0, nullptr);
+	preCmdList->ClearDepthStencilView(dsvPtr->_dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+#if GPU_CULLING
+	RecordGpuCulling(preCmdList);
+#endif
+	preCmdList->Close();
 
-	cmdQueuePtr->_cmdList->ClearDepthStencilView(depthStencilView, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+#if GPU_CULLING
+	//컬링과 인스턴스 모으기는 GPU가 했으므로 ExecuteIndirect 한 번
+	int chunkCount = 1;
+	{
+		ID3D12GraphicsCommandList* cmdList = cmdQueuePtr->BeginRecordList(0);
+		SetRenderState(cmdList);
+		gpuCullingPtr->RecordDraw(cmdList);
+		cmdList->Close();
+	}
+#else
+	//오브젝트를 덩어리로 나눠 스레드별 커맨드 리스트에 동시에 기록
+	int itemCount = static_cast<int>(_drawItems.size());
+	int chunkCount = min(RECORD_THREAD_COUNT, (itemCount + RECORD_CHUNK_MIN - 1) / RECORD_CHUNK_MIN);
+	renderThreadsPtr->Run(chunkCount, [&](int chunk)
+	{
+		ID3D12GraphicsCommandList* cmdList = cmdQueuePtr->BeginRecordList(chunk);
+		SetRenderState(cmdList);
+		RecordDrawItems(cmdList, itemCount * chunk / chunkCount, itemCount * (chunk + 1) / chunkCount);
+		cmdList->Close();
+	});
+#endif
 
-	cmdQueuePtr->_cmdList->SetPipelineState(psoPtr->_pipelineState.Get());
+	//렌더 종료
+	ID3D12GraphicsCommandList* postCmdList = cmdQueuePtr->_postCmdList.Get();
+	D3D12_RESOURCE_BARRIER barrier2 = CD3DX12_RESOURCE_BARRIER::Transition(swapChainPtr->_renderTargets[swapChainPtr->_backBufferIndex].Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT); // 화면 출력
+	postCmdList->ResourceBarrier(1, &barrier2);
+	postCmdList->Close();
 
-	//
-	for (int i = 0; i < PLAYERMAX; i++)
+	//시작, 스레드별 기록, 종료 리스트를 한 번에 제출
+	ID3D12CommandList* cmdListArr[RECORD_THREAD_COUNT + 2];
+	UINT cmdListCount = 0;
+	cmdListArr[cmdListCount++] = preCmdList;
+	for (int i = 0; i < chunkCount; i++)
+		cmdListArr[cmdListCount++] = cmdQueuePtr->_recordCmdList[i].Get();
+	cmdListArr[cmdListCount++] = postCmdList;
+	cmdQueuePtr->_cmdQueue->ExecuteCommandLists(cmdListCount, cmdListArr);
+
+	swapChainPtr->_swapChain->Present(0, 0);
+
+	//GPU 완료를 기다리지 않고 바로 다음 프레임 기록으로
+	cmdQueuePtr->EndFrame();
+
+	swapChainPtr->_backBufferIndex = (swapChainPtr->_backBufferIndex + 1) % SWAP_CHAIN_BUFFER_COUNT;
+}
+
+void DxEngine::BeginLoad()
+{
+	copyQueuePtr->BeginBatch();
+}
+
+void DxEngine::EndLoad()
+{
+	//그리기 큐가 GPU에서 복사 완료를 기다리므로 CPU는 바로 돌아옴
+	copyQueuePtr->EndBatch(cmdQueuePtr);
+}
+
+MeshHandle DxEngine::LoadMesh(const char* path)
+{
+	//에셋 팩 -> 낱개 캐시 -> FBX 순서로 찾고, 어디서 왔든 메쉬 캐시 모양(view)으로 올림
+	MeshCacheView view;
+	bool found = false;
+
+	//팩은 AssetCooker가 원본을 확인하고 구운 것이라 해시를 다시 보지 않음 (원본을 고치면 다시 구울 것)
+	const AssetPackEntry* entry = assetPackPtr->IsOpen() ? assetPackPtr->Find(AssetNameFromPath(path)) : nullptr;
+	if (entry && entry->type == ASSET_MESH)
+		found = ReadMeshCache(assetPackPtr->GetData(*entry), static_cast<size_t>(entry->size), 0, sizeof(GpuVertex), MESH_LOD_COUNT, view);
+
+	//캐시가 맞으면 FBX SDK 없이 매핑한 파일에서 바로 올림
+	string cachePath = string(path) + ".meshcache";
+	uint64_t sourceHash = 0;
+	MappedFile cacheFile;
+	if (!found)
 	{
-		if (playerArr[i].on == true)
+		sourceHash = MeshSourceHash(path);
+		found = cacheFile.Open(cachePath.c_str()) && ReadMeshCache(cacheFile._data, cacheFile._size, sourceHash, sizeof(GpuVertex), MESH_LOD_COUNT, view);
+	}
+
+	vector<uint8_t> cooked;
+	if (!found)
+	{
+		vector<Vertex> vertexVec;
+		vector<UINT> indexVec;
+		MeshBounds bounds;
+		if (!fbxLoaderPtr->LoadFbxData(vertexVec, indexVec, path, &bounds))
 		{
-			{
-				// ȯ
-				XMStoreFloat4x4(&vertexBufferPtr->_transform.world, XMMatrixScaling(1.0f, 1.0f, 1.0f) * XMMatrixTranslation(playerArr[i].transform.x, playerArr[i].transform.y, playerArr[i].transform.z));
-				XMMATRIX world = XMLoadFloat4x4(&vertexBufferPtr->_transform.world);
-				XMStoreFloat4x4(&vertexBufferPtr->_transform.world, XMMatrixTranspose(world));
-
-				//
-				cmdQueuePtr->_cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-				cmdQueuePtr->_cmdList->IASetVertexBuffers(0, 1, &vertexBufferPtr->_vertexBufferView);
-				cmdQueuePtr->_cmdList->IASetIndexBuffer(&indexBufferPtr->_indexBufferView);
-				{
-					D3D12_CPU_DESCRIPTOR_HANDLE handle = constantBufferPtr->PushData(0, &vertexBufferPtr->_transform, sizeof(vertexBufferPtr->_transform));
-					descHeapPtr->SetCBV(handle, 0, devicePtr);
-					D3D12_CPU_DESCRIPTOR_HANDLE handle2 = constantBufferPtr->PushData(1, &playerArr[networkPtr->myClientId].transform, sizeof(playerArr[networkPtr->myClientId].transform));
-					descHeapPtr->SetCBV(handle2, 1, devicePtr);
-					descHeapPtr->SetSRV(texturePtr->_srvHandle, 5, devicePtr);
-				}
-
-				descHeapPtr->CommitTable(cmdQueuePtr);
-				cmdQueuePtr->_cmdList->DrawIndexedInstanced(indexBufferPtr->_indexCount, 1, 0, 0, 0);
-			}
+			printf("mesh load: %s failed, objects using it are not drawn\n", path);
+			return INVALID_MESH_HANDLE;
 		}
+
+		MeshCookStats stats;
+		if (!BuildMeshCache(sourceHash, vertexVec, indexVec, bounds, cooked, &stats))
+		{
+			printf("mesh cook: %s failed, objects using it are not drawn\n", path);
+			return INVALID_MESH_HANDLE;
+		}
+		printf("mesh cook: %s ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", path, stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr);
+		if (sourceHash != 0)
+			WriteFileAtomic(cachePath.c_str(), cooked.data(), cooked.size());
+		found = ReadMeshCache(cooked.data(), cooked.size(), sourceHash, sizeof(GpuVertex), MESH_LOD_COUNT, view);
+		assert(found);
 	}
-	
-	for (int i = 0; i < NPCMAX; i++)
+
+	MeshLod lods[MESH_LOD_COUNT];
+	for (int lod = 0; lod < MESH_LOD_COUNT; lod++)
+	{
+		lods[lod].firstIndex = view.lods[lod].firstIndex;
+		lods[lod].indexCount = view.lods[lod].indexCount;
+	}
+	MeshBounds bounds;
+	bounds.box = BoundingBox(XMFLOAT3(view.bounds.boxCenter), XMFLOAT3(view.bounds.boxExtents));
+	bounds.sphere = BoundingSphere(XMFLOAT3(view.bounds.sphereCenter), view.bounds.sphereRadius);
+	return meshRegistryPtr->AddMesh(static_cast<const GpuVertex*>(view.vertices), view.vertexCount, view.indices, view.indexCount, lods, bounds, vertexBufferPtr, GetIndexBuffer(view.indexSize), copyQueuePtr, devicePtr);
+}
+
+void DxEngine::AddCullObject(const Obj& object)
+{
+	if (object.mesh == INVALID_MESH_HANDLE)
+		return;
+
+	//로컬 경계 구를 월드로 (균등 스케일 + 이동)
+	CullObject obj;
+	obj.mesh = object.mesh;
+	obj.scale = object.scale;
+	obj.position = object.transform;
+	_cullObjects.push_back(obj);
+
+	const BoundingSphere& sphere = meshRegistryPtr->GetMesh(object.mesh).bounds.sphere;
+	_cullSpheres.Add(sphere.Center.x * obj.scale + obj.position.x, sphere.Center.y * obj.scale + obj.position.y, sphere.Center.z * obj.scale + obj.position.z, sphere.Radius * obj.scale);
+}
+
+void DxEngine::UpdateCullInstance(int slot)
+{
+	//slot은 playerArr, npcArr 순서
+	bool isPlayer = (slot < PLAYERMAX);
+	const Obj& obj = isPlayer ? playerArr[slot] : npcArr[slot - PLAYERMAX];
+
+	CullInstance instance; //mesh가 INVALID_MESH_HANDLE이면 셰이더가 건너뜀
+	if ((!isPlayer || obj.on) && obj.mesh != INVALID_MESH_HANDLE)
 	{
+		float scale = obj.scale;
+		const BoundingSphere& sphere = meshRegistryPtr->GetMesh(obj.mesh).bounds.sphere;
+		XMMATRIX world = XMMatrixScaling(scale, scale, scale) * XMMatrixTranslation(obj.transform.x, obj.transform.y, obj.transform.z);
+		XMStoreFloat4x4(&instance.world, XMMatrixTranspose(world));
+		instance.sphere = XMFLOAT4(sphere.Center.x * scale + obj.transform.x, sphere.Center.y * scale + obj.transform.y, sphere.Center.z * scale + obj.transform.z, sphere.Radius * scale);
+		instance.mesh = obj.mesh;
+	}
+	gpuCullingPtr->SetInstance(slot, instance);
+}
+
+void DxEngine::UpdateCullMeshes()
+{
+	//메쉬 LOD별 그리기 인자 원본, 메쉬가 늘거나 텍스처가 올라가 SRV 번호가 바뀔 때만
+	_cullMeshCount = meshRegistryPtr->GetMeshCount();
+	_cullTextureIndex = texturePtr->_srvIndex;
+	for (UINT handle = 0; handle < _cullMeshCount; handle++)
+	{
+		const Mesh& mesh = meshRegistryPtr->GetMesh(handle);
+		ObjectConstants objectConstants;
+		objectConstants.textureIndex = texturePtr->_srvIndex;
+		objectConstants.positionScale = mesh.positionScale;
+		objectConstants.positionBias = mesh.positionBias;
+
+		IndirectCommand lodCommands[MESH_LOD_COUNT] = {};
+		for (int lod = 0; lod < MESH_LOD_COUNT; lod++)
 		{
-			// ȯ
-			XMStoreFloat4x4(&vertexBufferPtr->_transform.world, XMMatrixScaling(0.2f, 0.2f, 0.2f) * XMMatrixTranslation(npcArr[i].transform.x, npcArr[i].transform.y, npcArr[i].transform.z));
-			XMMATRIX world = XMLoadFloat4x4(&vertexBufferPtr->_transform.world);
-			XMStoreFloat4x4(&vertexBufferPtr->_transform.world, XMMatrixTranspose(world));
-
-			//
-			cmdQueuePtr->_cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-			cmdQueuePtr->_cmdList->IASetVertexBuffers(0, 1, &vertexBufferPtr->_npcVertexBufferView);
-			cmdQueuePtr->_cmdList->IASetIndexBuffer(&indexBufferPtr->_npcIndexBufferView);
-			{
-				D3D12_CPU_DESCRIPTOR_HANDLE handle = constantBufferPtr->PushData(0, &vertexBufferPtr->_transform, sizeof(vertexBufferPtr->_transform));
-				descHeapPtr->SetCBV(handle, 0, devicePtr);
-				descHeapPtr->SetSRV(texturePtr->_srvHandle, 5, devicePtr);
-			}
-
-			descHeapPtr->CommitTable(cmdQueuePtr);
-			cmdQueuePtr->_cmdList->DrawIndexedInstanced(indexBufferPtr->_indexCount, 1, 0, 0, 0);
+			lodCommands[lod].indexBuffer = GetIndexBuffer(mesh.indexSize)->_indexBufferView;
+			lodCommands[lod].drawArgs = { mesh.lods[lod].indexCount, 0, mesh.lods[lod].firstIndex, static_cast<INT>(mesh.baseVertex), 0 };
 		}
+		gpuCullingPtr->SetMesh(handle, objectConstants, lodCommands);
 	}
-	
+}
 
-	// 
-	D3D12_RESOURCE_BARRIER barrier2 = CD3DX12_RESOURCE_BARRIER::Transition(swapChainPtr->_renderTargets[swapChainPtr->_backBufferIndex].Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT); // ȭ 
+void DxEngine::RecordGpuCulling(ID3D12GraphicsCommandList* cmdList)
+{
+	//오브젝트와 메쉬 정보는 바뀔 때 Update에서 써 두었으므로 여기서는 절두체만 넘김
+	FrustumPlanes planes;
+	ExtractFrustumPlanes(&_viewProj.m[0][0], planes);
+	gpuCullingPtr->RecordCulling(cmdList, planes, _eyePosition, cameraPtr->mProj._22, constantBufferPtr, devicePtr);
+}
 
-	cmdQueuePtr->_cmdList->ResourceBarrier(1, &barrier2);
-	cmdQueuePtr->_cmdList->Close();
+void DxEngine::SetRenderState(ID3D12GraphicsCommandList* cmdList)
+{
+	//커맨드 리스트끼리는 상태가 이어지지 않으므로 리스트마다 다시 설정
+	cmdList->SetGraphicsRootSignature(rootSignaturePtr->_signature.Get());
+	ID3D12DescriptorHeap* descHeap = descHeapPtr->_descHeap.Get();
+	cmdList->SetDescriptorHeaps(1, &descHeap);
 
-	ID3D12CommandList* cmdListArr[] = { cmdQueuePtr->_cmdList.Get() };
-	cmdQueuePtr->_cmdQueue->ExecuteCommandLists(_countof(cmdListArr), cmdListArr);
+	cmdList->RSSetViewports(1, &_viewport);
+	cmdList->RSSetScissorRects(1, &_scissorRect);
 
-	swapChainPtr->_swapChain->Present(0, 0);
+	D3D12_CPU_DESCRIPTOR_HANDLE backBufferView = rtvPtr->_rtvHandle[swapChainPtr->_backBufferIndex];
+	D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = dsvPtr->_dsvHandle;
+	cmdList->OMSetRenderTargets(1, &backBufferView, FALSE, &depthStencilView);
 
-	cmdQueuePtr->WaitSync();
+	cmdList->SetPipelineState(psoPtr->_pipelineState.Get());
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-	swapChainPtr->_backBufferIndex = (swapChainPtr->_backBufferIndex + 1) % SWAP_CHAIN_BUFFER_COUNT;
-}
\ No newline at end of file
+	//모든 메쉬가 같은 정점 버퍼를 쓰므로 한 번만, 인덱스 버퍼는 대부분인 16비트를 걸어 둠
+	cmdList->IASetVertexBuffers(0, 1, &vertexBufferPtr->_vertexBufferView);
+	cmdList->IASetIndexBuffer(&indexBufferPtr->_indexBufferView);
+
+	//프레임 동안 바뀌지 않는 것들
+	cmdList->SetGraphicsRootConstantBufferView(ROOT_FRAME_CBV, _frameCB.gpuAddress);
+	descHeapPtr->CommitTable(cmdList);
+	cmdList->SetGraphicsRootShaderResourceView(ROOT_INSTANCES, instanceBufferPtr->GetFrameGpuVirtualAddress());
+}
+
+void DxEngine::RecordDrawItems(ID3D12GraphicsCommandList* cmdList, int first, int last)
+{
+	UINT boundIndexSize = indexBufferPtr->_indexSize; //SetRenderState가 건 것
+	for (int i = first; i < last; i++)
+	{
+		DrawItem& item = _drawItems[i];
+		const Mesh& mesh = meshRegistryPtr->GetMesh(item.mesh);
+
+		//정점이 많아 32비트 인덱스를 쓰는 메쉬만 바꿔 걸음
+		if (mesh.indexSize != boundIndexSize)
+		{
+			cmdList->IASetIndexBuffer(&GetIndexBuffer(mesh.indexSize)->_indexBufferView);
+			boundIndexSize = mesh.indexSize;
+		}
+
+		//렌더
+		{
+			ObjectConstants objectConstants;
+			objectConstants.textureIndex = item.textureIndex;
+			objectConstants.positionScale = mesh.positionScale;
+			objectConstants.positionBias = mesh.positionBias;
+			memcpy(item.objectCB.cpuAddress, &objectConstants, sizeof(objectConstants));
+			cmdList->SetGraphicsRootConstantBufferView(ROOT_OBJECT_CBV, item.objectCB.gpuAddress);
+		}
+
+		//SV_InstanceID는 StartInstanceLocation을 더해주지 않으므로 시작 번호는 루트 상수로 넘김
+		cmdList->SetGraphicsRoot32BitConstant(ROOT_INSTANCE_BASE, item.instanceBase, 0);
+		cmdList->DrawIndexedInstanced(item.indexCount, item.instanceCount, item.startIndex, item.baseVertex, 0);
+	}
+}
@@ -2,6 +2,7 @@
 #include "Util.h"
 #include "Device.h"
 #include "CmdQueue.h"
+#include "CopyQueue.h"
 #include "SwapChain.h"
 #include "RTV.h"
 #include "VertexBuffer.h"
@@ -17,19 +18,55 @@
 #include "Timer.h"
 #include "Input.h"
 #include "SFML.h"
+#include "RenderThreads.h"
+#include "InstanceBuffer.h"
+#include "FrustumCull.h"
+#include "GpuCulling.h"
+#include "MeshSimplify.h"
+#include "MeshOptimize.h"
+#include "MeshRegistry.h"
+#include "MipGen.h"
+#include "BcEncode.h"
+#include "MeshCache.h"
+#include "AssetPack.h"
+#include "AssetCook.h"
+
+//스레드별로 나눠 기록할 그리기 하나 (메쉬 LOD 하나의 인스턴스 전부)
+struct DrawItem
+{
+	UINT indexCount = 0;
+	UINT startIndex = 0; //LOD 범위 시작
+	INT baseVertex = 0; //공유 정점 버퍼 안에서 메쉬 시작
+	UINT instanceBase = 0; //이 프레임 인스턴스 버퍼 안에서의 시작 번호
+	UINT instanceCount = 0;
+	UINT textureIndex = 0; //재질 텍스처 (바인드리스 힙 번호)
+	MeshHandle mesh = 0; //PACKED_VERTEX 위치 복원 값을 가져올 메쉬
+	UploadAllocation objectCB; //미리 잡아둔 b1 영역
+};
+
+//컬링 대상 하나
+struct CullObject
+{
+	MeshHandle mesh = 0;
+	float scale = 1.0f;
+	int lod = 0;
+	XMFLOAT4 position = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+};
 
 class DxEngine {
 public:
-	//DX ʱȭ
+	~DxEngine();
+
+	//DX엔진 초기화
 	void Init(WindowInfo windowInfo);
 	
-	// Ӹ Ʈ
+	//매 프레임마다 업데이트
 	void Update(WindowInfo windowInfo, bool isActive);
 
-	// Ӹ ׸
+	//매 프레임마다 그리기
 	void Draw();
 
-	//Һ ü 
+	//요소별 객체 포인터
 	shared_ptr<Device> devicePtr = make_shared<Device>();
 	shared_ptr<CmdQueue> cmdQueuePtr = make_shared<CmdQueue>();
 	shared_ptr<SwapChain> swapChainPtr = make_shared<SwapChain>();
@@ -39,7 +76,8 @@ public:
 	shared_ptr<PSO> psoPtr = make_shared<PSO>();
 	shared_ptr<ConstantBuffer> constantBufferPtr = make_shared<ConstantBuffer>();
 	shared_ptr<DescHeap> descHeapPtr = make_shared<DescHeap>();
-	shared_ptr<IndexBuffer> indexBufferPtr = make_shared<IndexBuffer>();
+	shared_ptr<IndexBuffer> indexBufferPtr = make_shared<IndexBuffer>(); //16비트
+	shared_ptr<IndexBuffer> indexBuffer32Ptr = make_shared<IndexBuffer>(); //정점이 많은 메쉬만
 	shared_ptr<Texture> texturePtr = make_shared<Texture>();
 	shared_ptr<DSV> dsvPtr = make_shared<DSV>();
 	shared_ptr<Camera> cameraPtr = make_shared<Camera>();
@@ -47,13 +85,62 @@ public:
 	shared_ptr<Timer> timerPtr = make_shared<Timer>();
 	shared_ptr<Input> inputPtr = make_shared<Input>();
 	shared_ptr<SFML> networkPtr = make_shared<SFML>();
+	shared_ptr<RenderThreads> renderThreadsPtr = make_shared<RenderThreads>();
+	shared_ptr<InstanceBuffer> instanceBufferPtr = make_shared<InstanceBuffer>();
+	shared_ptr<GpuCulling> gpuCullingPtr = make_shared<GpuCulling>();
+	shared_ptr<MeshRegistry> meshRegistryPtr = make_shared<MeshRegistry>();
+	shared_ptr<CopyQueue> copyQueuePtr = make_shared<CopyQueue>();
+	shared_ptr<TextureStreamer> textureStreamerPtr = make_shared<TextureStreamer>();
+	shared_ptr<AssetPack> assetPackPtr = make_shared<AssetPack>();
 
-	//Ʈ ü 
+	//정적 리소스 로드 묶음, 사이의 업로드는 복사 큐 커맨드 리스트 하나로 모아 한 번에 제출
+	void BeginLoad();
+	void EndLoad();
+	//fbx를 읽어 LOD를 만들고 공유 버퍼에 등록 (BeginLoad와 EndLoad 사이에서)
+	//에셋 팩에 있으면 그것을 쓰고, 없으면 결과를 path.meshcache로 저장해 두고 원본이 그대로면 다음부터 그것을 매핑해서 씀
+	MeshHandle LoadMesh(const char* path); //실패하면 INVALID_MESH_HANDLE
+
+	//오브젝트 객체 생성
 	Obj playerArr[PLAYERMAX];
 	Obj npcArr[NPCMAX];
 
 private:
-	//ȭ ũ 
+	//그리기 목록
+	vector<DrawItem> _drawItems;
+	//이번 프레임의 b0 (뷰, 투영, 조명)
+	UploadAllocation _frameCB;
+
+	//절두체 컬링
+	XMFLOAT4X4 _viewProj = Identity4x4();
+	XMFLOAT3 _eyePosition = XMFLOAT3(0.0f, 0.0f, 0.0f); //LOD 선택용
+	CullSpheres _cullSpheres;
+	vector<CullObject> _cullObjects;
+	vector<uint32_t> _visible;
+	vector<UINT> _bucketStart; //메쉬 LOD별 시작 위치 (_sortedVisible 안)
+	vector<UINT> _bucketCursor;
+	vector<uint32_t> _sortedVisible;
+
+	//컬링 대상 추가, 경계 구를 월드 공간으로 옮겨 넣음
+	void AddCullObject(const Obj& object);
+	//GPU_CULLING: 바뀐 오브젝트 하나(playerArr, npcArr 순서 번호)의 컬링 입력을 다시 씀
+	void UpdateCullInstance(int slot);
+	//GPU_CULLING: 메쉬별 b1과 그리기 인자 원본을 다시 씀
+	void UpdateCullMeshes();
+	//GPU_CULLING: 바뀐 칸 올리기, 인자 초기화, 컬링 디스패치를 기록
+	void RecordGpuCulling(ID3D12GraphicsCommandList* cmdList);
+	bool _cullInstancesReady = false;
+	UINT _cullMeshCount = 0; //UpdateCullMeshes 때의 메쉬 수와 텍스처 번호
+	UINT _cullTextureIndex = DescriptorAllocator::INVALID_INDEX;
+
+	//인덱스 크기(2, 4)에 맞는 공유 인덱스 버퍼
+	shared_ptr<IndexBuffer> GetIndexBuffer(UINT indexSize) const { return indexSize == sizeof(uint16_t) ? indexBufferPtr : indexBuffer32Ptr; }
+
+	//기록 스레드마다 커맨드 리스트의 공통 상태 설정
+	void SetRenderState(ID3D12GraphicsCommandList* cmdList);
+	//_drawItems[first, last) 기록
+	void RecordDrawItems(ID3D12GraphicsCommandList* cmdList, int first, int last);
+
+	//화면 크기 관련
 	D3D12_VIEWPORT	_viewport;
 	D3D12_RECT		_scissorRect;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "FbxLoader.h"
+#include "MeshOptimize.h"
 
-void FbxLoader::LoadFbxData(vector<Vertex>& vertexVec, vector<UINT>& indexVec, const char* path) {
+bool FbxLoader::LoadFbxData(vector<Vertex>& vertexVec, vector<UINT>& indexVec, const char* path, MeshBounds* bounds) {
 	FbxManager* lSdkManager = FbxManager::Create();
 	FbxIOSettings* ios = FbxIOSettings::Create(lSdkManager, IOSROOT);
 	lSdkManager->SetIOSettings(ios);
@@ -10,8 +11,38 @@ void FbxLoader::LoadFbxData(vector<Vertex>& vertexVec, vector<UINT>& indexVec, c
 	bool lResult;
 
 	lResult = LoadScene(lSdkManager, lScene, path);
-	FbxNode* lNode = lScene->GetRootNode();
-	DisplayContent(lNode, vertexVec, indexVec);
+	if (lResult)
+	{
+		FbxNode* lNode = lScene->GetRootNode();
+		DisplayContent(lNode, vertexVec, indexVec);
+	}
+
+	//씬, 임포터 설정까지 같이 해제
+	lSdkManager->Destroy();
+
+	if (bounds)
+		ComputeBounds(vertexVec, *bounds);
+	return lResult && !vertexVec.empty() && !indexVec.empty();
+}
+
+void FbxLoader::ComputeBounds(const vector<Vertex>& vertexVec, MeshBounds& bounds)
+{
+	if (vertexVec.empty())
+	{
+		bounds = MeshBounds();
+		return;
+	}
+
+	BoundingBox::CreateFromPoints(bounds.box, vertexVec.size(), &vertexVec[0].pos, sizeof(Vertex));
+
+	//구 중심은 AABB 중심, 반지름은 가장 먼 정점까지 (AABB 대각선보다 작음)
+	XMVECTOR center = XMLoadFloat3(&bounds.box.Center);
+	XMVECTOR maxDistSq = XMVectorZero();
+	for (const Vertex& v : vertexVec)
+		maxDistSq = XMVectorMax(maxDistSq, XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&v.pos), center)));
+
+	bounds.sphere.Center = bounds.box.Center;
+	bounds.sphere.Radius = XMVectorGetX(XMVectorSqrt(maxDistSq));
 }
 
 bool FbxLoader::LoadScene(FbxManager* pManager, FbxDocument* pScene, const char* pFilename)
@@ -159,74 +190,71 @@ void FbxLoader::DisplayContent(FbxNode* pNode, vector<Vertex>& vertexVec, vector
 
 void FbxLoader::DisplayPolygons(FbxMesh* pMesh, vector<Vertex>& vertexVec, vector<UINT>& indexVec)
 {
-	int count = pMesh->GetControlPointsCount();
-	vertexVec.resize(count);
-
 	FbxVector4* controlPoints = pMesh->GetControlPoints();
-
-	for (int i = 0; i < count; i++)
+	FbxGeometryElementUV* uvElement = pMesh->GetElementUV();
+	const char* uvSetName = uvElement ? uvElement->GetName() : nullptr;
+
+	//모서리(폴리곤 정점)마다 위치, 노멀, UV를 모음
+	//같은 제어점이라도 이음새에서는 노멀, UV가 달라서 제어점 하나에 덮어쓰면 안 됨
+	vector<Vertex> corners;
+	vector<UINT> cornerIndices;
+	corners.reserve(pMesh->GetPolygonVertexCount());
+	cornerIndices.reserve(pMesh->GetPolygonVertexCount());
+
+	int polygonCount = pMesh->GetPolygonCount();
+	for (int i = 0; i < polygonCount; i++)
 	{
-		vertexVec[i].pos.x = static_cast<float>(controlPoints[i].mData[0]);
-		vertexVec[i].pos.y = static_cast<float>(controlPoints[i].mData[2]);
-		vertexVec[i].pos.z = static_cast<float>(controlPoints[i].mData[1]);
-	}
-
-	int triCount = pMesh->GetPolygonCount();
-
-	indexVec.resize(triCount * 3);
-
-	FbxGeometryElementMaterial* geometryElementMaterial = pMesh->GetElementMaterial();
-
-	const int polygonSize = pMesh->GetPolygonSize(0);
-	assert(polygonSize == 3);
-
-	UINT arrIdx[3];
-	UINT vertexCounter = 0; // 
-
-	for (int i = 0; i < triCount; i++)
-	{
-		for (int j = 0; j < 3; j++)
+		int polygonSize = pMesh->GetPolygonSize(i);
+		UINT first = static_cast<UINT>(corners.size());
+		for (int j = 0; j < polygonSize; j++)
 		{
 			int controlPointIndex = pMesh->GetPolygonVertex(i, j);
-			arrIdx[j] = controlPointIndex;
-
-			//Normal ε
-			if (pMesh->GetElementNormalCount() == 0)
-				return;
-
-			FbxGeometryElementNormal* normal = pMesh->GetElementNormal();
-			UINT normalIdx = 0;
-
-			if (normal->GetMappingMode() == FbxGeometryElement::eByPolygonVertex)
+			Vertex vertex = {};
+			if (controlPointIndex >= 0)
 			{
-				if (normal->GetReferenceMode() == FbxGeometryElement::eDirect)
-					normalIdx = vertexCounter;
-				else
-					normalIdx = normal->GetIndexArray().GetAt(vertexCounter);
+				vertex.pos.x = static_cast<float>(controlPoints[controlPointIndex].mData[0]);
+				vertex.pos.y = static_cast<float>(controlPoints[controlPointIndex].mData[2]);
+				vertex.pos.z = static_cast<float>(controlPoints[controlPointIndex].mData[1]);
 			}
-			else if (normal->GetMappingMode() == FbxGeometryElement::eByControlPoint)
+
+			//Normal 로드 (매핑 모드는 SDK가 처리), 없으면 0
+			FbxVector4 normal;
+			if (pMesh->GetPolygonVertexNormal(i, j, normal))
 			{
-				if (normal->GetReferenceMode() == FbxGeometryElement::eDirect)
-					normalIdx = controlPointIndex;
-				else
-					normalIdx = normal->GetIndexArray().GetAt(controlPointIndex);
+				vertex.color.x = static_cast<float>(normal.mData[0]);
+				vertex.color.y = static_cast<float>(normal.mData[2]);
+				vertex.color.z = static_cast<float>(normal.mData[1]);
 			}
 
-			FbxVector4 vec = normal->GetDirectArray().GetAt(normalIdx);
-			vertexVec[controlPointIndex].color.x = static_cast<float>(vec.mData[0]);
-			vertexVec[controlPointIndex].color.y = static_cast<float>(vec.mData[2]);
-			vertexVec[controlPointIndex].color.z = static_cast<float>(vec.mData[1]);
-
-			//UV ε
-			FbxVector2 uv = pMesh->GetElementUV()->GetDirectArray().GetAt(pMesh->GetTextureUVIndex(i, j));
-			vertexVec[controlPointIndex].uv.x = static_cast<float>(uv.mData[0]);
-			vertexVec[controlPointIndex].uv.y = 1.f - static_cast<float>(uv.mData[1]);
+			//UV 로드, 없으면 0
+			FbxVector2 uv;
+			bool unmapped = false;
+			if (uvSetName && pMesh->GetPolygonVertexUV(i, j, uvSetName, uv, unmapped) && !unmapped)
+			{
+				vertex.uv.x = static_cast<float>(uv.mData[0]);
+				vertex.uv.y = 1.f - static_cast<float>(uv.mData[1]);
+			}
 
-			vertexCounter++;
+			corners.push_back(vertex);
 		}
 
-		indexVec.push_back(arrIdx[0]);
-		indexVec.push_back(arrIdx[2]);
-		indexVec.push_back(arrIdx[1]);
+		//삼각형이 아니면 부채꼴로 나눔, y와 z를 바꿨으므로 감는 순서도 뒤집음 (0, 2, 1)
+		for (int j = 1; j + 1 < polygonSize; j++)
+		{
+			cornerIndices.push_back(first);
+			cornerIndices.push_back(first + j + 1);
+			cornerIndices.push_back(first + j);
+		}
 	}
+
+	//같은 모서리 정점을 하나로 합쳐 이 메쉬 정점을 앞 메쉬 뒤에 붙임
+	vector<uint32_t> remap;
+	size_t uniqueCount = WeldVertices(corners.data(), sizeof(Vertex), corners.size(), remap);
+	UINT base = static_cast<UINT>(vertexVec.size());
+	vertexVec.resize(base + uniqueCount);
+	RemapVertices(vertexVec.data() + base, corners.data(), sizeof(Vertex), corners.size(), remap);
+
+	indexVec.reserve(indexVec.size() + cornerIndices.size());
+	for (UINT index : cornerIndices)
+		indexVec.push_back(base + remap[index]);
 }
\ No newline at end of file
@@ -10,15 +10,19 @@
 class FbxLoader
 {
 public:
-	void LoadFbxData(vector<Vertex>& vertexVec, vector<UINT>& indexVec, const char* path);
+	//파일을 못 읽었거나 삼각형이 없으면 false (vertexVec, indexVec에는 아무것도 붙지 않음)
+	bool LoadFbxData(vector<Vertex>& vertexVec, vector<UINT>& indexVec, const char* path, MeshBounds* bounds = nullptr);
+
+	//정점들을 감싸는 AABB와 구 계산
+	static void ComputeBounds(const vector<Vertex>& vertexVec, MeshBounds& bounds);
 
 private:
-	//fbx ε
+	//fbx씬 로드
 	bool LoadScene(FbxManager* pManager, FbxDocument* pScene, const char* pFilename);
 
-	//带 鼭 ͸ ֱ Լ ȣ
+	//노드를 돌면서 데이터를 넣기위해 재귀함수 호출
 	void DisplayContent(FbxNode* pNode, vector<Vertex>& vertexVec, vector<UINT>& indexVec);
 
-	//ؽͿ εͿ  Ľؼ ֱ
+	//버텍스벡터와 인덱스벡터에 데이터 파싱해서 넣기 (모서리마다 모아 같은 정점을 합친 뒤 뒤에 붙임)
 	void DisplayPolygons(FbxMesh* pMesh, vector<Vertex>& vertexVec, vector<UINT>& indexVec);
 };
\ No newline at end of file
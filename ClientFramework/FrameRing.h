@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+//프레임 리소스 링
+//CPU가 프레임 N+1을 기록하는 동안 GPU는 프레임 N을 실행한다.
+//프레임 슬롯(커맨드 할당자, 상수 버퍼 영역, 디스크립터 범위)마다 마지막으로 제출한 펜스 값을 기억해 두고
+//슬롯을 다시 쓰기 전에 그 값까지만 기다린다.
+//
+//Queue는 아래 세 함수만 있으면 됨 (GPU 없이 가짜 큐로 검사 가능)
+//	uint64_t Signal();					//새 펜스 값을 큐에 넣고 그 값을 반환
+//	uint64_t CompletedValue();			//GPU가 끝낸 마지막 펜스 값
+//	void WaitFor(uint64_t value);		//value까지 끝날 때까지 CPU 대기
+template<class Queue, unsigned int Count>
+class FrameRing
+{
+public:
+	static_assert(Count >= 1, "need at least one frame");
+
+	unsigned int	_frameIndex = 0;
+	uint64_t		_frameFence[Count] = {}; //슬롯별 마지막 제출 펜스 값, 0이면 아직 안 씀
+
+	//프레임 시작, 현재 슬롯을 쓰던 GPU 작업이 끝날 때까지 기다림 (기다렸으면 true)
+	bool BeginFrame(Queue& queue)
+	{
+		uint64_t fence = _frameFence[_frameIndex];
+		if (fence != 0 && queue.CompletedValue() < fence)
+		{
+			queue.WaitFor(fence);
+			return true;
+		}
+		return false;
+	}
+
+	//프레임 제출 후, 현재 슬롯에 펜스 값을 기록하고 다음 슬롯으로
+	void EndFrame(Queue& queue)
+	{
+		_frameFence[_frameIndex] = queue.Signal();
+		_frameIndex = (_frameIndex + 1) % Count;
+	}
+
+	//모든 슬롯의 GPU 작업이 끝날 때까지 대기 (종료, 리소스 교체 전)
+	void WaitIdle(Queue& queue)
+	{
+		uint64_t last = 0;
+		for (unsigned int i = 0; i < Count; i++)
+			if (_frameFence[i] > last) last = _frameFence[i];
+		if (last != 0 && queue.CompletedValue() < last)
+			queue.WaitFor(last);
+	}
+};
@@ -0,0 +1,200 @@
+#include "FrustumCull.h"
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+void ExtractFrustumPlanes(const float m[16], FrustumPlanes& planes)
+{
+	//clip = v * M 이므로 열 j = (m[0][j], m[1][j], m[2][j], m[3][j])
+	auto col = [&](int j, int i) { return m[i * 4 + j]; };
+
+	float p[6][4];
+	for (int i = 0; i < 4; i++)
+	{
+		p[0][i] = col(3, i) + col(0, i); //왼쪽   -w <= x
+		p[1][i] = col(3, i) - col(0, i); //오른쪽  x <= w
+		p[2][i] = col(3, i) + col(1, i); //아래   -w <= y
+		p[3][i] = col(3, i) - col(1, i); //위      y <= w
+		p[4][i] = col(2, i);             //가까운  0 <= z (D3D)
+		p[5][i] = col(3, i) - col(2, i); //먼      z <= w
+	}
+
+	for (int k = 0; k < 6; k++)
+	{
+		float len = sqrtf(p[k][0] * p[k][0] + p[k][1] * p[k][1] + p[k][2] * p[k][2]);
+		float inv = len > 0.0f ? 1.0f / len : 0.0f;
+		planes.a[k] = p[k][0] * inv;
+		planes.b[k] = p[k][1] * inv;
+		planes.c[k] = p[k][2] * inv;
+		planes.d[k] = p[k][3] * inv;
+	}
+}
+
+void CullSpheres::Clear()
+{
+	_x.clear();
+	_y.clear();
+	_z.clear();
+	_r.clear();
+	_count = 0;
+}
+
+int CullSpheres::Add(float x, float y, float z, float radius)
+{
+	//4개 단위로 칸을 늘리고 새 칸은 항상 실패하는 값으로 (-1이면 절두체 안쪽 깊은 원점은 통과함)
+	if (_count % 4 == 0)
+	{
+		_x.resize(_count + 4, 0.0f);
+		_y.resize(_count + 4, 0.0f);
+		_z.resize(_count + 4, 0.0f);
+		_r.resize(_count + 4, -FLT_MAX);
+	}
+	_x[_count] = x;
+	_y[_count] = y;
+	_z[_count] = z;
+	_r[_count] = radius;
+	return _count++;
+}
+
+int CullSpheresSSE(const FrustumPlanes& planes, const CullSpheres& spheres, uint32_t* visible)
+{
+	__m128 pa[6], pb[6], pc[6], pd[6];
+	for (int k = 0; k < 6; k++)
+	{
+		pa[k] = _mm_set1_ps(planes.a[k]);
+		pb[k] = _mm_set1_ps(planes.b[k]);
+		pc[k] = _mm_set1_ps(planes.c[k]);
+		pd[k] = _mm_set1_ps(planes.d[k]);
+	}
+
+	int visibleCount = 0;
+	for (int i = 0; i < spheres._count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(&spheres._x[i]);
+		__m128 y = _mm_loadu_ps(&spheres._y[i]);
+		__m128 z = _mm_loadu_ps(&spheres._z[i]);
+		__m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres._r[i]));
+
+		//모든 평면에서 거리 >= -r 이면 보임
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int k = 0; k < 6; k++)
+		{
+			__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[k], x), _mm_mul_ps(pb[k], y)), _mm_add_ps(_mm_mul_ps(pc[k], z), pd[k]));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negR));
+		}
+
+		//마지막 묶음의 남는 칸은 값과 상관없이 버림 (visible은 _count개까지만)
+		int mask = _mm_movemask_ps(inside);
+		if (spheres._count - i < 4)
+			mask &= (1 << (spheres._count - i)) - 1;
+		while (mask)
+		{
+			int lane = 0;
+			while (((mask >> lane) & 1) == 0) lane++;
+			visible[visibleCount++] = static_cast<uint32_t>(i + lane);
+			mask &= mask - 1;
+		}
+	}
+	return visibleCount;
+}
+
+int CullSpheresScalar(const FrustumPlanes& planes, const CullSpheres& spheres, uint32_t* visible)
+{
+	int visibleCount = 0;
+	for (int i = 0; i < spheres._count; i++)
+	{
+		bool inside = true;
+		for (int k = 0; k < 6 && inside; k++)
+		{
+			float dist = planes.a[k] * spheres._x[i] + planes.b[k] * spheres._y[i] + planes.c[k] * spheres._z[i] + planes.d[k];
+			inside = dist >= -spheres._r[i];
+		}
+		if (inside)
+			visible[visibleCount++] = static_cast<uint32_t>(i);
+	}
+	return visibleCount;
+}
+
+void RunCullBenchmark(int objectCount)
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	//(0, 0, eyeZ)에서 +z를 보는 카메라 (fov 45도, 1:1, near 1, far 1000) 의 뷰-투영 행렬
+	auto makePlanes = [](float eyeZ, FrustumPlanes& planes)
+	{
+		float yScale = 1.0f / tanf(0.25f * 3.14159265f * 0.5f);
+		float farZ = 1000.0f, nearZ = 1.0f;
+		float zScale = farZ / (farZ - nearZ);
+		float viewZ = -eyeZ; //뷰 행렬의 이동
+		float viewProj[16] =
+		{
+			yScale, 0.0f, 0.0f, 0.0f,
+			0.0f, yScale, 0.0f, 0.0f,
+			0.0f, 0.0f, zScale, 1.0f,
+			0.0f, 0.0f, viewZ * zScale - nearZ * zScale, viewZ,
+		};
+		ExtractFrustumPlanes(viewProj, planes);
+	};
+	FrustumPlanes planes;
+	makePlanes(0.0f, planes);
+
+	//SSE와 스칼라가 같은 번호를 내는지, 남는 칸이 있는 개수와 원점이 절두체 안쪽 깊이 있는 카메라로 검사
+	//(게임 카메라는 원점보다 10 정도 뒤에 있음)
+	auto checkParity = [](const FrustumPlanes& checkPlanes, const CullSpheres& checkSpheres)
+	{
+		std::vector<uint32_t> scalarVisible(checkSpheres._count), sseVisible(checkSpheres._count);
+		int scalarCount = CullSpheresScalar(checkPlanes, checkSpheres, scalarVisible.data());
+		int sseCount = CullSpheresSSE(checkPlanes, checkSpheres, sseVisible.data());
+		bool same = scalarCount == sseCount && std::equal(scalarVisible.begin(), scalarVisible.begin() + scalarCount, sseVisible.begin());
+		if (!same)
+			printf("  MISMATCH : %d spheres, scalar %d visible, sse %d visible\n", checkSpheres._count, scalarCount, sseCount);
+		assert(same);
+		return same;
+	};
+	{
+		FrustumPlanes offsetPlanes;
+		makePlanes(-10.0f, offsetPlanes);
+		for (int count = 1; count <= 8; count++)
+		{
+			CullSpheres small;
+			for (int i = 0; i < count; i++)
+				small.Add(static_cast<float>(i % 3) - 1.0f, 0.0f, static_cast<float>(i) * 5.0f, 1.0f);
+			checkParity(planes, small);
+			checkParity(offsetPlanes, small);
+		}
+	}
+
+	//카메라 주변 큐브 안에 무작위로 흩뿌림
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> radius(0.5f, 5.0f);
+	CullSpheres spheres;
+	for (int i = 0; i < objectCount; i++)
+		spheres.Add(pos(rng), pos(rng), pos(rng), radius(rng));
+
+	std::vector<uint32_t> visible(objectCount);
+	const int repeat = 200;
+
+	auto measure = [&](int (*cull)(const FrustumPlanes&, const CullSpheres&, uint32_t*), int& visibleCount)
+	{
+		auto t0 = clock::now();
+		for (int n = 0; n < repeat; n++)
+			visibleCount = cull(planes, spheres, visible.data());
+		return std::chrono::duration<double, std::nano>(clock::now() - t0).count() / repeat;
+	};
+
+	int scalarVisible = 0, sseVisible = 0;
+	double scalarNs = measure(CullSpheresScalar, scalarVisible);
+	double sseNs = measure(CullSpheresSSE, sseVisible);
+
+	printf("Cull benchmark : %d objects, %d visible\n", objectCount, sseVisible);
+	printf("  scalar %.1f us (%.2f ns/object)\n", scalarNs / 1000.0, scalarNs / objectCount);
+	printf("  sse    %.1f us (%.2f ns/object)\n", sseNs / 1000.0, sseNs / objectCount);
+	checkParity(planes, spheres);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//절두체 컬링 (GPU 없이 동작)
+//경계 구를 SoA로 모아두고 4개씩 SSE로 6개 평면과 검사한다.
+
+//정규화된 평면 6개 (왼, 오, 아래, 위, 가까운, 먼), ax + by + cz + d >= 0 이 안쪽
+struct FrustumPlanes
+{
+	float a[6];
+	float b[6];
+	float c[6];
+	float d[6];
+};
+
+//행 벡터 기준 (v * M) 뷰-투영 행렬에서 평면 추출, m은 row-major 4x4
+void ExtractFrustumPlanes(const float m[16], FrustumPlanes& planes);
+
+//월드 공간 경계 구 목록, 길이는 항상 4의 배수로 채워 둠 (남는 칸은 반지름 -FLT_MAX, 검사 결과에서도 뺌)
+class CullSpheres
+{
+public:
+	std::vector<float> _x;
+	std::vector<float> _y;
+	std::vector<float> _z;
+	std::vector<float> _r;
+	int _count = 0;
+
+	void Clear();
+	//구 하나 추가, 번호 반환
+	int Add(float x, float y, float z, float radius);
+};
+
+//보이는 구의 번호를 오름차순으로 visible에 쓰고 개수 반환 (visible은 spheres._count개 이상)
+int CullSpheresSSE(const FrustumPlanes& planes, const CullSpheres& spheres, uint32_t* visible);
+//같은 결과를 내는 스칼라 버전 (비교, 검증용)
+int CullSpheresScalar(const FrustumPlanes& planes, const CullSpheres& spheres, uint32_t* visible);
+
+//CPU만 쓰는 컬링 비용 측정, 결과는 콘솔로 출력
+void RunCullBenchmark(int objectCount);
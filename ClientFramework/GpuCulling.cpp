@@ -0,0 +1,313 @@
+#include "Device.h"
+#include "RootSignature.h"
+#include "GpuCulling.h"
+#include <fstream>
+
+void GetIndirectArgumentDescs(D3D12_INDIRECT_ARGUMENT_DESC* descs, UINT& count)
+{
+	count = 0;
+
+	descs[count] = {};
+	descs[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW;
+	descs[count].ConstantBufferView.RootParameterIndex = ROOT_OBJECT_CBV;
+	count++;
+
+	descs[count] = {};
+	descs[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+	count++;
+
+	descs[count] = {};
+	descs[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+	descs[count].Constant.RootParameterIndex = ROOT_INSTANCE_BASE;
+	descs[count].Constant.DestOffsetIn32BitValues = 0;
+	descs[count].Constant.Num32BitValuesToSet = 1;
+	count++;
+
+	descs[count] = {};
+	descs[count].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED; //그리기는 항상 마지막
+	count++;
+}
+
+UINT GetIndirectArgumentsSize(const D3D12_INDIRECT_ARGUMENT_DESC* descs, UINT count)
+{
+	UINT size = 0;
+	for (UINT i = 0; i < count; i++)
+	{
+		switch (descs[i].Type)
+		{
+		case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW: size += sizeof(D3D12_DRAW_ARGUMENTS); break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED: size += sizeof(D3D12_DRAW_INDEXED_ARGUMENTS); break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH: size += sizeof(D3D12_DISPATCH_ARGUMENTS); break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW: size += sizeof(D3D12_VERTEX_BUFFER_VIEW); break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW: size += sizeof(D3D12_INDEX_BUFFER_VIEW); break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT: size += descs[i].Constant.Num32BitValuesToSet * sizeof(UINT); break;
+		default: size += sizeof(D3D12_GPU_VIRTUAL_ADDRESS); break; //CBV, SRV, UAV
+		}
+	}
+	return size;
+}
+
+//Cull.hlsl에서 "#define name 값"의 값, 없으면 -1
+static int ReadHlslDefine(const string& source, const char* name)
+{
+	string key = string("#define ") + name + " ";
+	size_t at = source.find(key);
+	return at == string::npos ? -1 : atoi(source.c_str() + at + key.size());
+}
+
+void RunIndirectLayoutCheck(int unused)
+{
+	int failures = 0;
+	auto check = [&failures](bool ok, const char* what)
+	{
+		printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+		if (!ok)
+			failures++;
+	};
+
+	//커맨드 시그니처 인자 목록 (CreateGpuCulling과 같은 함수)
+	D3D12_INDIRECT_ARGUMENT_DESC descs[8];
+	UINT count = 0;
+	GetIndirectArgumentDescs(descs, count);
+	printf("indirect layout: %u arguments, IndirectCommand %zu bytes\n", count, sizeof(IndirectCommand));
+
+	check(GetIndirectArgumentsSize(descs, count) == sizeof(IndirectCommand), "packed argument size == sizeof(IndirectCommand)");
+	check(count == 4, "argument count == 4");
+	if (count == 4)
+	{
+		check(descs[0].Type == D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW && descs[0].ConstantBufferView.RootParameterIndex == ROOT_OBJECT_CBV, "CBV -> ROOT_OBJECT_CBV (objectCB)");
+		check(descs[1].Type == D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW, "INDEX_BUFFER_VIEW (indexBuffer)");
+		check(descs[2].Type == D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT && descs[2].Constant.RootParameterIndex == ROOT_INSTANCE_BASE
+			&& descs[2].Constant.DestOffsetIn32BitValues == 0 && descs[2].Constant.Num32BitValuesToSet == 1, "CONSTANT x1 -> ROOT_INSTANCE_BASE (instanceBase)");
+	}
+	check(count > 0 && descs[count - 1].Type == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, "DRAW_INDEXED is last (drawArgs)");
+	bool onlyOneDraw = true;
+	for (UINT i = 0; i + 1 < count; i++)
+		onlyOneDraw = onlyOneDraw && descs[i].Type != D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED && descs[i].Type != D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+	check(onlyOneDraw, "no draw argument before the last");
+
+	//셰이더는 매크로로 C++ 값을 받지만, 기본값이 어긋나 있으면 매크로 없이 컴파일한 도구가 틀린 위치를 씀
+	ifstream file("..\\Cull.hlsl");
+	string source((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	check(!source.empty(), "..\\Cull.hlsl readable (same path CreateGpuCulling compiles)");
+	int hlslStride = ReadHlslDefine(source, "INDIRECT_COMMAND_STRIDE");
+	int hlslCountOffset = ReadHlslDefine(source, "INDIRECT_INSTANCE_COUNT_OFFSET");
+	printf("  Cull.hlsl defaults: stride %d, InstanceCount offset %d\n", hlslStride, hlslCountOffset);
+	check(hlslStride == 48 && hlslCountOffset == 32, "Cull.hlsl defaults are stride 48, offset 32");
+	check(sizeof(IndirectCommand) == static_cast<size_t>(hlslStride), "sizeof(IndirectCommand) == INDIRECT_COMMAND_STRIDE");
+	check(INDIRECT_INSTANCE_COUNT_OFFSET == static_cast<UINT>(hlslCountOffset), "INDIRECT_INSTANCE_COUNT_OFFSET == Cull.hlsl default");
+
+	printf(failures == 0 ? "indirect layout: all checks passed\n" : "indirect layout: %d checks FAILED\n", failures);
+	assert(failures == 0);
+}
+
+void GpuCulling::CreateGpuCulling(UINT maxMeshCount, UINT lodCount, UINT instanceCapacity, UINT sceneCapacity, shared_ptr<Device> devicePtr, shared_ptr<RootSignature> rootSignaturePtr)
+{
+	_maxMeshCount = maxMeshCount;
+	_lodCount = lodCount;
+	_instanceCapacity = instanceCapacity;
+	_sceneCapacity = sceneCapacity;
+
+	//컴퓨트 루트 시그니처 : b0 상수, t0 전체 인스턴스, u0 보이는 인스턴스, u1 그리기 인자
+	CD3DX12_ROOT_PARAMETER param[4];
+	param[0].InitAsConstantBufferView(0);
+	param[1].InitAsShaderResourceView(0);
+	param[2].InitAsUnorderedAccessView(0);
+	param[3].InitAsUnorderedAccessView(1);
+
+	D3D12_ROOT_SIGNATURE_DESC sigDesc = CD3DX12_ROOT_SIGNATURE_DESC(_countof(param), param);
+
+	ComPtr<ID3DBlob> blobSignature;
+	ComPtr<ID3DBlob> blobError;
+	::D3D12SerializeRootSignature(&sigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &blobSignature, &blobError);
+	devicePtr->_device->CreateRootSignature(0, blobSignature->GetBufferPointer(), blobSignature->GetBufferSize(), IID_PPV_ARGS(&_cullSignature));
+
+	//셰이더의 인자 배치 상수는 C++ 구조체에서 가져옴
+	string stride = to_string(sizeof(IndirectCommand));
+	string countOffset = to_string(INDIRECT_INSTANCE_COUNT_OFFSET);
+	D3D_SHADER_MACRO macros[] =
+	{
+		{ "INDIRECT_COMMAND_STRIDE", stride.c_str() },
+		{ "INDIRECT_INSTANCE_COUNT_OFFSET", countOffset.c_str() },
+		{ nullptr, nullptr },
+	};
+	D3DCompileFromFile(L"..\\Cull.hlsl", macros, D3D_COMPILE_STANDARD_FILE_INCLUDE, "CS_Main", "cs_5_1", 0, 0, &_csBlob, &_errBlob);
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC pipelineDesc = {};
+	pipelineDesc.pRootSignature = _cullSignature.Get();
+	pipelineDesc.CS = { _csBlob->GetBufferPointer(), _csBlob->GetBufferSize() };
+	devicePtr->_device->CreateComputePipelineState(&pipelineDesc, IID_PPV_ARGS(&_cullPipelineState));
+
+	//커맨드 시그니처, 루트 인자를 바꾸므로 그래픽 루트 시그니처가 필요
+	D3D12_INDIRECT_ARGUMENT_DESC argDescs[8];
+	UINT argCount = 0;
+	GetIndirectArgumentDescs(argDescs, argCount);
+	assert(GetIndirectArgumentsSize(argDescs, argCount) == sizeof(IndirectCommand));
+
+	D3D12_COMMAND_SIGNATURE_DESC commandSignatureDesc = {};
+	commandSignatureDesc.pArgumentDescs = argDescs;
+	commandSignatureDesc.NumArgumentDescs = argCount;
+	commandSignatureDesc.ByteStride = sizeof(IndirectCommand);
+	devicePtr->_device->CreateCommandSignature(&commandSignatureDesc, rootSignaturePtr->_signature.Get(), IID_PPV_ARGS(&_commandSignature));
+
+	//기본 힙 버퍼 (GPU만 씀)
+	UINT commandCount = _maxMeshCount * _lodCount;
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+	D3D12_RESOURCE_DESC visibleDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(InstanceData) * commandCount * _instanceCapacity, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &visibleDesc, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, nullptr, IID_PPV_ARGS(&_visibleInstances));
+
+	D3D12_RESOURCE_DESC argsDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(IndirectCommand) * commandCount, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &argsDesc, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, nullptr, IID_PPV_ARGS(&_indirectArgs));
+
+	//바뀔 때만 복사로 채우는 버퍼
+	D3D12_RESOURCE_DESC sceneDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(CullInstance) * _sceneCapacity);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &sceneDesc, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, nullptr, IID_PPV_ARGS(&_sceneInstances));
+
+	D3D12_RESOURCE_DESC objectDesc = CD3DX12_RESOURCE_DESC::Buffer(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT * _maxMeshCount);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &objectDesc, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, nullptr, IID_PPV_ARGS(&_objectConstants));
+
+	D3D12_RESOURCE_DESC templateDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(IndirectCommand) * commandCount);
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &templateDesc, D3D12_RESOURCE_STATE_COPY_SOURCE, nullptr, IID_PPV_ARGS(&_commandTemplate));
+
+	//처음에는 모든 칸이 빈 칸, 첫 RecordCulling에서 한 번 다 올림
+	_instances.assign(_sceneCapacity, CullInstance());
+	_instanceDirty.assign(_sceneCapacity, 1);
+	_dirtyInstances.resize(_sceneCapacity);
+	for (UINT slot = 0; slot < _sceneCapacity; slot++)
+		_dirtyInstances[slot] = slot;
+	_meshConstants.assign(_maxMeshCount, ObjectConstants());
+	_commands.assign(commandCount, IndirectCommand());
+	_meshCount = 0;
+	_meshesDirty = false;
+}
+
+void GpuCulling::SetInstance(UINT slot, const CullInstance& instance)
+{
+	assert(slot < _sceneCapacity);
+	_instances[slot] = instance;
+	if (!_instanceDirty[slot])
+	{
+		_instanceDirty[slot] = 1;
+		_dirtyInstances.push_back(slot);
+	}
+}
+
+void GpuCulling::SetMesh(UINT mesh, const ObjectConstants& constants, const IndirectCommand* lodCommands)
+{
+	assert(mesh < _maxMeshCount);
+	_meshConstants[mesh] = constants;
+
+	//b1은 메쉬마다 (PACKED_VERTEX의 위치 복원 값이 메쉬마다 다름)
+	D3D12_GPU_VIRTUAL_ADDRESS objectCB = _objectConstants->GetGPUVirtualAddress() + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT * mesh;
+	for (UINT lod = 0; lod < _lodCount; lod++) //Cull.hlsl과 같은 순서 (메쉬 * LOD 수 + LOD)
+	{
+		UINT slot = mesh * _lodCount + lod;
+		IndirectCommand& command = _commands[slot];
+		command = lodCommands[lod];
+		command.objectCB = objectCB;
+		command.instanceBase = slot * _instanceCapacity;
+		command.drawArgs.InstanceCount = 0;
+		command.drawArgs.StartInstanceLocation = 0;
+	}
+	_meshCount = max(_meshCount, mesh + 1);
+	_meshesDirty = true;
+}
+
+void GpuCulling::RecordCulling(ID3D12GraphicsCommandList* cmdList, const FrustumPlanes& planes, const XMFLOAT3& eyePosition, float projScaleY, shared_ptr<ConstantBuffer> constantBufferPtr, shared_ptr<Device> devicePtr)
+{
+	//바뀐 오브젝트 칸만 올림
+	if (!_dirtyInstances.empty())
+	{
+		UINT dirtyCount = static_cast<UINT>(_dirtyInstances.size());
+		UploadAllocation upload = constantBufferPtr->Allocate(sizeof(CullInstance) * dirtyCount, devicePtr);
+		D3D12_RESOURCE_BARRIER toCopy = CD3DX12_RESOURCE_BARRIER::Transition(_sceneInstances.Get(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+		cmdList->ResourceBarrier(1, &toCopy);
+		for (UINT i = 0; i < dirtyCount; i++)
+		{
+			UINT slot = _dirtyInstances[i];
+			memcpy(upload.cpuAddress + sizeof(CullInstance) * i, &_instances[slot], sizeof(CullInstance));
+			cmdList->CopyBufferRegion(_sceneInstances.Get(), sizeof(CullInstance) * slot, upload.resource, upload.offset + sizeof(CullInstance) * i, sizeof(CullInstance));
+			_instanceDirty[slot] = 0;
+		}
+		D3D12_RESOURCE_BARRIER toRead = CD3DX12_RESOURCE_BARRIER::Transition(_sceneInstances.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		cmdList->ResourceBarrier(1, &toRead);
+		_dirtyInstances.clear();
+	}
+
+	//메쉬나 재질이 바뀌었을 때만 b1과 그리기 인자 원본을 다시 올림
+	if (_meshesDirty && _meshCount > 0)
+	{
+		UINT commandBytes = sizeof(IndirectCommand) * _meshCount * _lodCount;
+		UINT constantBytes = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT * _meshCount;
+		UploadAllocation commands = constantBufferPtr->PushData(_commands.data(), commandBytes, devicePtr);
+		UploadAllocation constants = constantBufferPtr->Allocate(constantBytes, devicePtr);
+		for (UINT mesh = 0; mesh < _meshCount; mesh++)
+			memcpy(constants.cpuAddress + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT * mesh, &_meshConstants[mesh], sizeof(ObjectConstants));
+
+		D3D12_RESOURCE_BARRIER toCopy[] =
+		{
+			CD3DX12_RESOURCE_BARRIER::Transition(_commandTemplate.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COPY_DEST),
+			CD3DX12_RESOURCE_BARRIER::Transition(_objectConstants.Get(), D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER, D3D12_RESOURCE_STATE_COPY_DEST),
+		};
+		cmdList->ResourceBarrier(_countof(toCopy), toCopy);
+		cmdList->CopyBufferRegion(_commandTemplate.Get(), 0, commands.resource, commands.offset, commandBytes);
+		cmdList->CopyBufferRegion(_objectConstants.Get(), 0, constants.resource, constants.offset, constantBytes);
+		D3D12_RESOURCE_BARRIER toRead[] =
+		{
+			CD3DX12_RESOURCE_BARRIER::Transition(_commandTemplate.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COPY_SOURCE),
+			CD3DX12_RESOURCE_BARRIER::Transition(_objectConstants.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER),
+		};
+		cmdList->ResourceBarrier(_countof(toRead), toRead);
+	}
+	_meshesDirty = false;
+
+	CullConstants cullConstants;
+	for (int i = 0; i < 6; i++)
+		cullConstants.planes[i] = XMFLOAT4(planes.a[i], planes.b[i], planes.c[i], planes.d[i]);
+	cullConstants.eyePosition = XMFLOAT4(eyePosition.x, eyePosition.y, eyePosition.z, projScaleY);
+	float lodScreenSize[4] = {};
+	for (UINT lod = 0; lod + 1 < _lodCount && lod < MESH_LOD_COUNT - 1; lod++)
+		lodScreenSize[lod] = LOD_SCREEN_SIZE[lod];
+	cullConstants.lodScreenSize = XMFLOAT4(lodScreenSize);
+	cullConstants.instanceCount = _sceneCapacity;
+	cullConstants.instanceCapacity = _instanceCapacity;
+	cullConstants.lodCount = _lodCount;
+	cullConstants.meshCount = _meshCount;
+	UploadAllocation cullCB = constantBufferPtr->PushData(&cullConstants, sizeof(cullConstants), devicePtr);
+
+	//이번 프레임 인자를 InstanceCount 0인 원본으로 초기화 (GPU 안에서 복사)
+	D3D12_RESOURCE_BARRIER toCopy[] =
+	{
+		CD3DX12_RESOURCE_BARRIER::Transition(_indirectArgs.Get(), D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_RESOURCE_STATE_COPY_DEST),
+		CD3DX12_RESOURCE_BARRIER::Transition(_visibleInstances.Get(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+	};
+	cmdList->ResourceBarrier(_countof(toCopy), toCopy);
+	if (_meshCount > 0)
+		cmdList->CopyBufferRegion(_indirectArgs.Get(), 0, _commandTemplate.Get(), 0, sizeof(IndirectCommand) * _meshCount * _lodCount);
+
+	D3D12_RESOURCE_BARRIER toUav = CD3DX12_RESOURCE_BARRIER::Transition(_indirectArgs.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	cmdList->ResourceBarrier(1, &toUav);
+
+	//오브젝트 칸 하나당 스레드 하나 (빈 칸은 셰이더가 바로 끝냄)
+	cmdList->SetComputeRootSignature(_cullSignature.Get());
+	cmdList->SetPipelineState(_cullPipelineState.Get());
+	cmdList->SetComputeRootConstantBufferView(0, cullCB.gpuAddress);
+	cmdList->SetComputeRootShaderResourceView(1, _sceneInstances->GetGPUVirtualAddress());
+	cmdList->SetComputeRootUnorderedAccessView(2, _visibleInstances->GetGPUVirtualAddress());
+	cmdList->SetComputeRootUnorderedAccessView(3, _indirectArgs->GetGPUVirtualAddress());
+	if (_meshCount > 0)
+		cmdList->Dispatch((_sceneCapacity + 63) / 64, 1, 1);
+
+	D3D12_RESOURCE_BARRIER toDraw[] =
+	{
+		CD3DX12_RESOURCE_BARRIER::Transition(_indirectArgs.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+		CD3DX12_RESOURCE_BARRIER::Transition(_visibleInstances.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE),
+	};
+	cmdList->ResourceBarrier(_countof(toDraw), toDraw);
+}
+
+void GpuCulling::RecordDraw(ID3D12GraphicsCommandList* cmdList)
+{
+	cmdList->SetGraphicsRootShaderResourceView(ROOT_INSTANCES, _visibleInstances->GetGPUVirtualAddress());
+	cmdList->ExecuteIndirect(_commandSignature.Get(), _meshCount * _lodCount, _indirectArgs.Get(), 0, nullptr, 0);
+}
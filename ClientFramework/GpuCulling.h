@@ -0,0 +1,105 @@
+#pragma once
+#include "Util.h"
+#include "ConstantBuffer.h"
+#include "FrustumCull.h"
+#include <cstddef>
+
+//GPU 컬링 + ExecuteIndirect
+//오브젝트 정보(월드 행렬, 경계 구, 메쉬 번호)와 메쉬별 그리기 인자는 GPU 버퍼에 계속 두고 바뀐 칸만 다시 올린다.
+//보이는지 판단, 메쉬별 인스턴스 모으기, 그리기 인자 작성은 컴퓨트 셰이더(Cull.hlsl)가 한다.
+
+//컴퓨트 셰이더 입력, Cull.hlsl의 CullInstance와 같은 배치
+struct CullInstance
+{
+	XMFLOAT4X4 world; //전치된 월드 행렬 (InstanceData 그대로)
+	XMFLOAT4 sphere; //월드 공간 경계 구 (xyz 중심, w 반지름)
+	UINT mesh = INVALID_MESH_HANDLE; //빈 칸이나 그리지 않는 오브젝트는 셰이더가 건너뜀
+	UINT padding[3] = {};
+};
+
+//컴퓨트 셰이더 상수 (b0)
+struct CullConstants
+{
+	XMFLOAT4 planes[6];
+	XMFLOAT4 eyePosition; //xyz 카메라 위치, w 투영 행렬 _22 (화면 크기 계산)
+	XMFLOAT4 lodScreenSize; //LOD_SCREEN_SIZE
+	UINT instanceCount = 0;
+	UINT instanceCapacity = 0; //메쉬 LOD 하나가 gVisibleInstances에서 쓸 수 있는 칸 수 (넘치면 셰이더가 버림)
+	UINT lodCount = 0;
+	UINT meshCount = 0; //이보다 큰 메쉬 번호는 그리지 않음
+};
+
+//ExecuteIndirect 인자 하나 (메쉬 LOD 하나, 메쉬 * lodCount + LOD 순서)
+//인자는 커맨드 시그니처에 적은 순서대로 빈틈없이 붙으므로 멤버 순서와 크기가 그대로 맞아야 한다.
+struct IndirectCommand
+{
+	D3D12_GPU_VIRTUAL_ADDRESS objectCB;			//ROOT_OBJECT_CBV
+	D3D12_INDEX_BUFFER_VIEW indexBuffer;		//메쉬의 인덱스 크기에 맞는 공유 인덱스 버퍼 (16/32비트)
+	UINT instanceBase;							//ROOT_INSTANCE_BASE
+	D3D12_DRAW_INDEXED_ARGUMENTS drawArgs;		//InstanceCount는 컴퓨트 셰이더가 채움, 정점/인덱스 버퍼는 공유라 메쉬 위치만
+};
+
+//시그니처 인자 순서대로 쌓은 크기와 구조체 배치가 같은지 컴파일 타임 검사
+static_assert(offsetof(IndirectCommand, objectCB) == 0, "indirect layout");
+static_assert(offsetof(IndirectCommand, indexBuffer) == offsetof(IndirectCommand, objectCB) + sizeof(D3D12_GPU_VIRTUAL_ADDRESS), "indirect layout");
+static_assert(offsetof(IndirectCommand, instanceBase) == offsetof(IndirectCommand, indexBuffer) + sizeof(D3D12_INDEX_BUFFER_VIEW), "indirect layout");
+static_assert(offsetof(IndirectCommand, drawArgs) == offsetof(IndirectCommand, instanceBase) + sizeof(UINT), "indirect layout");
+static_assert(sizeof(IndirectCommand) == offsetof(IndirectCommand, drawArgs) + sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), "indirect command must have no tail padding");
+static_assert(MESH_LOD_COUNT - 1 <= 4, "LOD thresholds must fit in lodScreenSize");
+static_assert(sizeof(CullInstance) == 96 && sizeof(CullConstants) == 144, "must match Cull.hlsl");
+
+//컴퓨트 셰이더가 InstanceCount를 올릴 바이트 위치
+constexpr UINT INDIRECT_INSTANCE_COUNT_OFFSET = static_cast<UINT>(offsetof(IndirectCommand, drawArgs) + offsetof(D3D12_DRAW_INDEXED_ARGUMENTS, InstanceCount));
+
+//커맨드 시그니처 인자 목록, count에 개수
+void GetIndirectArgumentDescs(D3D12_INDIRECT_ARGUMENT_DESC* descs, UINT& count);
+//인자 목록을 빈틈없이 쌓았을 때의 바이트 수
+UINT GetIndirectArgumentsSize(const D3D12_INDIRECT_ARGUMENT_DESC* descs, UINT count);
+//인자 목록과 IndirectCommand, Cull.hlsl 기본값이 맞는지 GPU 없이 검사 (--indirect-check)
+void RunIndirectLayoutCheck(int unused);
+
+class GpuCulling
+{
+public:
+	ComPtr<ID3D12RootSignature>		_cullSignature;
+	ComPtr<ID3D12PipelineState>		_cullPipelineState;
+	ComPtr<ID3D12CommandSignature>	_commandSignature;
+	ComPtr<ID3DBlob>				_csBlob;
+	ComPtr<ID3DBlob>				_errBlob;
+
+	ComPtr<ID3D12Resource>			_sceneInstances; //오브젝트 번호별 CullInstance
+	ComPtr<ID3D12Resource>			_objectConstants; //메쉬별 b1 (ObjectConstants, 256바이트 간격)
+	ComPtr<ID3D12Resource>			_commandTemplate; //메쉬 LOD별 IndirectCommand 원본 (InstanceCount 0), 매 프레임 _indirectArgs로 복사
+	ComPtr<ID3D12Resource>			_visibleInstances; //메쉬 LOD별로 instanceCapacity칸씩, InstanceData
+	ComPtr<ID3D12Resource>			_indirectArgs; //메쉬 LOD별 IndirectCommand
+
+	UINT _maxMeshCount = 0;
+	UINT _meshCount = 0; //SetMesh로 채운 메쉬 수
+	UINT _lodCount = 1;
+	UINT _instanceCapacity = 0;
+	UINT _sceneCapacity = 0; //오브젝트 칸 수
+
+	//GPU 버퍼의 CPU 사본, 바뀐 것만 다음 RecordCulling에서 올림
+	vector<CullInstance> _instances;
+	vector<UINT> _dirtyInstances;
+	vector<uint8_t> _instanceDirty;
+	vector<ObjectConstants> _meshConstants;
+	vector<IndirectCommand> _commands;
+	bool _meshesDirty = false;
+
+	//컴퓨트 루트 시그니처, PSO, 커맨드 시그니처, 버퍼 생성
+	//sceneCapacity는 오브젝트 칸 수, 처음에는 모두 빈 칸
+	void CreateGpuCulling(UINT maxMeshCount, UINT lodCount, UINT instanceCapacity, UINT sceneCapacity, shared_ptr<Device> devicePtr, shared_ptr<RootSignature> rootSignaturePtr);
+
+	//오브젝트 slot의 정보가 바뀌었을 때만 부름 (그리지 않으면 mesh를 INVALID_MESH_HANDLE로)
+	void SetInstance(UINT slot, const CullInstance& instance);
+	//메쉬가 등록되거나 재질이 바뀌었을 때만 부름
+	//lodCommands는 LOD별 indexBuffer와 drawArgs만 채워서 넘기고, objectCB와 instanceBase는 여기서 채움
+	void SetMesh(UINT mesh, const ObjectConstants& constants, const IndirectCommand* lodCommands);
+
+	//프레임 시작 커맨드 리스트에 기록: 바뀐 칸 올리기 -> 인자 초기화 -> 컬링 디스패치 -> 그리기용 상태로 전환
+	void RecordCulling(ID3D12GraphicsCommandList* cmdList, const FrustumPlanes& planes, const XMFLOAT3& eyePosition, float projScaleY, shared_ptr<ConstantBuffer> constantBufferPtr, shared_ptr<Device> devicePtr);
+
+	//그리기 커맨드 리스트에 기록
+	void RecordDraw(ID3D12GraphicsCommandList* cmdList);
+};
@@ -1,14 +1,20 @@
 #pragma once
 #include "Util.h"
+
+//모든 메쉬가 같이 쓰는 인덱스 버퍼 (기본 힙), 메쉬(LOD)마다 앞에서부터 잘라 씀
+//인덱스 크기(16/32비트)마다 하나씩 만든다.
 class IndexBuffer
 {
 public:
 	ComPtr<ID3D12Resource> _indexBuffer;
-	D3D12_INDEX_BUFFER_VIEW _indexBufferView;
-	ComPtr<ID3D12Resource> _npcIndexBuffer;
-	D3D12_INDEX_BUFFER_VIEW _npcIndexBufferView;
-	UINT _indexCount = 0;
+	D3D12_INDEX_BUFFER_VIEW _indexBufferView = {};
+	UINT _indexSize = 0; //바이트, 2면 R16_UINT, 4면 R32_UINT
+	UINT _capacity = 0; //인덱스 수
+	UINT _indexCount = 0; //지금까지 쓴 인덱스 수
 
-	//ε  
-	void CreateIndexBuffer(const vector<UINT>& buffer, shared_ptr<Device> devicePtr, int isPlayer); //isPlayer : ÷̾ ε  npcε , ߿ modelindexε     ְ int ص
-};
\ No newline at end of file
+	//인덱스 버퍼 생성 (indexSize바이트 인덱스 capacity개)
+	void CreateIndexBuffer(UINT indexSize, UINT capacity, shared_ptr<Device> devicePtr);
+	//인덱스 추가 (복사 큐 배치에 기록), 시작 인덱스 번호(StartIndexLocation) 반환
+	//indices는 _indexSize바이트씩
+	UINT AddIndices(const void* indices, UINT count, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<Device> devicePtr);
+};
@@ -6,7 +6,7 @@ void Input::Init()
 	_states.resize(255);
 }
 
-void Input::InputKey(shared_ptr<Timer> timerPtr, Obj* playerArr, shared_ptr<SFML> networkPtr)
+bool Input::InputKey(shared_ptr<Timer> timerPtr, Obj* playerArr, shared_ptr<SFML> networkPtr)
 {
 	HWND hwnd = GetActiveWindow();
 
@@ -35,55 +35,52 @@ void Input::InputKey(shared_ptr<Timer> timerPtr, Obj* playerArr, shared_ptr<SFML
 		playerArr[networkPtr->myClientId].transform.x += 5.0f * timerPtr->_deltaTime * cosf(XM_PI / 2.0f);
 		playerArr[networkPtr->myClientId].transform.z += 5.0f * timerPtr->_deltaTime * sinf(XM_PI / 2.0f);
 
-		CS_MOVE_PACKET p;
-		p.size = sizeof(p);
-		p.type = CS_MOVE;
+		CS_MOVE_PACKET p = make_packet<CS_MOVE_PACKET>();
 		//p.degree = playerArr[myClientId].rotate.y;
 		p.x = playerArr[networkPtr->myClientId].transform.x;
 		p.y = playerArr[networkPtr->myClientId].transform.y;
 		p.z = playerArr[networkPtr->myClientId].transform.z;
-		networkPtr->send_packet(&p);
+		networkPtr->send_packet(p);
+		return true;
 	}
 	else if (_states['S'] == 1)
 	{
 		playerArr[networkPtr->myClientId].transform.x -= 5.0f * timerPtr->_deltaTime * cosf(XM_PI / 2.0f);
 		playerArr[networkPtr->myClientId].transform.z -= 5.0f * timerPtr->_deltaTime * sinf(XM_PI / 2.0f);
 
-		CS_MOVE_PACKET p;
-		p.size = sizeof(p);
-		p.type = CS_MOVE;
+		CS_MOVE_PACKET p = make_packet<CS_MOVE_PACKET>();
 		//p.degree = playerArr[myClientId].rotate.y;
 		p.x = playerArr[networkPtr->myClientId].transform.x;
 		p.y = playerArr[networkPtr->myClientId].transform.y;
 		p.z = playerArr[networkPtr->myClientId].transform.z;
-		networkPtr->send_packet(&p);
+		networkPtr->send_packet(p);
+		return true;
 	}
 	else if (_states['A'] == 1)
 	{
 		playerArr[networkPtr->myClientId].transform.x -= 5.0f * timerPtr->_deltaTime * cosf(0.0f);
 		playerArr[networkPtr->myClientId].transform.z -= 5.0f * timerPtr->_deltaTime * sinf(0.0f);
 
-		CS_MOVE_PACKET p;
-		p.size = sizeof(p);
-		p.type = CS_MOVE;
+		CS_MOVE_PACKET p = make_packet<CS_MOVE_PACKET>();
 		//p.degree = playerArr[myClientId].rotate.y;
 		p.x = playerArr[networkPtr->myClientId].transform.x;
 		p.y = playerArr[networkPtr->myClientId].transform.y;
 		p.z = playerArr[networkPtr->myClientId].transform.z;
-		networkPtr->send_packet(&p);
+		networkPtr->send_packet(p);
+		return true;
 	}
 	else if (_states['D'] == 1)
 	{
 		playerArr[networkPtr->myClientId].transform.x += 5.0f * timerPtr->_deltaTime * cosf(0.0f);
 		playerArr[networkPtr->myClientId].transform.z += 5.0f * timerPtr->_deltaTime * sinf(0.0f);
 
-		CS_MOVE_PACKET p;
-		p.size = sizeof(p);
-		p.type = CS_MOVE;
+		CS_MOVE_PACKET p = make_packet<CS_MOVE_PACKET>();
 		//p.degree = playerArr[myClientId].rotate.y;
 		p.x = playerArr[networkPtr->myClientId].transform.x;
 		p.y = playerArr[networkPtr->myClientId].transform.y;
 		p.z = playerArr[networkPtr->myClientId].transform.z;
-		networkPtr->send_packet(&p);
+		networkPtr->send_packet(p);
+		return true;
 	}
+	return false;
 }
\ No newline at end of file
@@ -7,9 +7,9 @@ class Input
 public:
 	vector<int> _states;
 
-	//  ʱȭ
+	//벡터 사이즈 초기화
 	void Init();
 
-	//Ű Է
-	void InputKey(shared_ptr<Timer> timerPtr, Obj* playerArr, shared_ptr<SFML> networkPtr);
+	//키 입력, 내 플레이어를 움직였으면 true
+	bool InputKey(shared_ptr<Timer> timerPtr, Obj* playerArr, shared_ptr<SFML> networkPtr);
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "Device.h"
+#include "InstanceBuffer.h"
+
+void InstanceBuffer::CreateInstanceBuffer(UINT count, shared_ptr<Device> devicePtr)
+{
+	_elementCount = count;
+
+	UINT bufferSize = sizeof(InstanceData) * _elementCount * FRAME_COUNT;
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+
+	devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&_instanceBuffer));
+
+	_instanceBuffer->Map(0, nullptr, reinterpret_cast<void**>(&_mappedBuffer));
+}
+
+void InstanceBuffer::BeginFrame(UINT frameIndex)
+{
+	_frameIndex = frameIndex;
+	_currentIndex = 0;
+}
+
+UINT InstanceBuffer::PushInstance(const InstanceData& data)
+{
+	assert(_currentIndex < _elementCount);
+
+	_mappedBuffer[_frameIndex * _elementCount + _currentIndex] = data;
+	return _currentIndex++;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS InstanceBuffer::GetFrameGpuVirtualAddress()
+{
+	return _instanceBuffer->GetGPUVirtualAddress() + static_cast<UINT64>(_frameIndex) * _elementCount * sizeof(InstanceData);
+}
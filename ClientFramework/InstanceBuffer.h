@@ -0,0 +1,21 @@
+#pragma once
+#include "Util.h"
+class InstanceBuffer
+{
+public:
+	ComPtr<ID3D12Resource>	_instanceBuffer;
+	InstanceData* _mappedBuffer = nullptr;
+	UINT _elementCount = 0; //프레임 하나가 쓸 수 있는 인스턴스 수, 버퍼는 FRAME_COUNT배
+
+	UINT _frameIndex = 0;
+	UINT _currentIndex = 0;
+
+	//인스턴스 버퍼(StructuredBuffer) 생성
+	void CreateInstanceBuffer(UINT count, shared_ptr<Device> devicePtr);
+	//프레임 시작, 이 프레임 슬롯의 영역을 처음부터 사용
+	void BeginFrame(UINT frameIndex);
+	//인스턴스 하나 추가, 이 프레임 영역 안에서의 번호 반환
+	UINT PushInstance(const InstanceData& data);
+	//이 프레임 영역의 시작 주소 (루트 SRV로 바인딩)
+	D3D12_GPU_VIRTUAL_ADDRESS GetFrameGpuVirtualAddress();
+};
@@ -0,0 +1,237 @@
+#include "MeshCache.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const char* path)
+{
+	Close();
+	HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	_file = file;
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	_mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	_data = static_cast<const uint8_t*>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (_data == nullptr)
+	{
+		Close();
+		return false;
+	}
+	_size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (_data)
+		::UnmapViewOfFile(_data);
+	if (_mapping)
+		::CloseHandle(_mapping);
+	if (_file)
+		::CloseHandle(_file);
+	_data = nullptr;
+	_size = 0;
+	_mapping = nullptr;
+	_file = nullptr;
+}
+#else
+bool MappedFile::Open(const char* path)
+{
+	Close();
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+	void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); //매핑은 fd를 닫아도 유지됨
+	if (data == MAP_FAILED)
+		return false;
+
+	_data = static_cast<const uint8_t*>(data);
+	_size = static_cast<size_t>(st.st_size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (_data)
+		::munmap(const_cast<uint8_t*>(_data), _size);
+	_data = nullptr;
+	_size = 0;
+}
+#endif
+
+uint64_t Fnv1a(const void* data, size_t size, uint64_t hash)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+uint64_t HashFile(const char* path)
+{
+	MappedFile file;
+	if (!file.Open(path))
+		return 0;
+	uint64_t hash = Fnv1a(file._data, file._size);
+	return hash != 0 ? hash : 1; //0은 "원본 없음"으로 쓰므로
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t align)
+{
+	return (value + align - 1) & ~(align - 1);
+}
+
+bool WriteFileAtomic(const char* path, const void* data, size_t size)
+{
+	//다른 프로세스가 반쯤 쓴 파일을 읽지 않도록 임시 파일에 쓰고 바꿔치기
+	std::string tempPath = std::string(path) + ".tmp";
+	FILE* file = fopen(tempPath.c_str(), "wb");
+	if (file == nullptr)
+		return false;
+
+	bool ok = size == 0 || fwrite(data, 1, size, file) == size;
+	ok = (fclose(file) == 0) && ok;
+	if (ok)
+	{
+		remove(path); //Windows rename은 덮어쓰지 않음
+		ok = rename(tempPath.c_str(), path) == 0;
+	}
+	if (!ok)
+		remove(tempPath.c_str());
+	return ok;
+}
+
+bool SerializeMeshCache(uint64_t sourceHash, const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+	const uint32_t* indices, uint32_t indexCount, const MeshCacheLod* lods, uint32_t lodCount, const MeshCacheBounds& bounds, std::vector<uint8_t>& out)
+{
+	if (lodCount > MESH_CACHE_MAX_LOD)
+		return false;
+
+	MeshCacheHeader header = {};
+	memcpy(header.magic, "MSHC", 4);
+	header.version = MESH_CACHE_VERSION;
+	header.sourceHash = sourceHash;
+	header.vertexStride = vertexStride;
+	header.vertexCount = vertexCount;
+	header.indexCount = indexCount;
+	header.indexSize = MeshIndexSize(vertexCount);
+	header.lodCount = lodCount;
+	memcpy(header.lods, lods, sizeof(MeshCacheLod) * lodCount);
+	header.bounds = bounds;
+	header.vertexOffset = AlignUp(sizeof(MeshCacheHeader), 16);
+	header.indexOffset = AlignUp(header.vertexOffset + static_cast<uint64_t>(vertexStride) * vertexCount, 16);
+	header.fileSize = header.indexOffset + static_cast<uint64_t>(indexCount) * header.indexSize;
+
+	//정렬용 빈칸은 0
+	out.assign(static_cast<size_t>(header.fileSize), 0);
+	memcpy(out.data(), &header, sizeof(header));
+	if (vertexCount > 0)
+		memcpy(out.data() + header.vertexOffset, vertices, static_cast<size_t>(vertexStride) * vertexCount);
+	if (header.indexSize == sizeof(uint32_t))
+	{
+		if (indexCount > 0)
+			memcpy(out.data() + header.indexOffset, indices, sizeof(uint32_t) * indexCount);
+	}
+	else
+	{
+		uint16_t* narrow = reinterpret_cast<uint16_t*>(out.data() + header.indexOffset);
+		for (uint32_t i = 0; i < indexCount; i++)
+		{
+			if (indices[i] >= vertexCount)
+			{
+				out.clear(); //반쯤 쓴 내용을 캐시나 팩에 쓰지 않도록
+				return false;
+			}
+			narrow[i] = static_cast<uint16_t>(indices[i]);
+		}
+	}
+	return true;
+}
+
+bool WriteMeshCache(const char* path, uint64_t sourceHash, const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+	const uint32_t* indices, uint32_t indexCount, const MeshCacheLod* lods, uint32_t lodCount, const MeshCacheBounds& bounds)
+{
+	std::vector<uint8_t> bytes;
+	if (!SerializeMeshCache(sourceHash, vertices, vertexStride, vertexCount, indices, indexCount, lods, lodCount, bounds, bytes))
+		return false;
+	return WriteFileAtomic(path, bytes.data(), bytes.size());
+}
+
+bool ReadMeshCache(const uint8_t* data, size_t size, uint64_t sourceHash, uint32_t vertexStride, uint32_t lodCount, MeshCacheView& view)
+{
+	if (data == nullptr || size < sizeof(MeshCacheHeader))
+		return false;
+
+	MeshCacheHeader header;
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, "MSHC", 4) != 0 || header.version != MESH_CACHE_VERSION)
+		return false;
+	if (sourceHash != 0 && header.sourceHash != sourceHash)
+		return false;
+	if (header.vertexStride != vertexStride || header.lodCount != lodCount || header.lodCount > MESH_CACHE_MAX_LOD)
+		return false;
+
+	//잘린 파일, 범위를 벗어난 덩어리 거르기
+	uint64_t vertexBytes = static_cast<uint64_t>(header.vertexStride) * header.vertexCount;
+	if (header.indexSize != MeshIndexSize(header.vertexCount))
+		return false;
+	uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * header.indexSize;
+	if (header.fileSize != size || header.vertexOffset % 16 != 0 || header.indexOffset % 16 != 0)
+		return false;
+	if (header.vertexOffset < sizeof(header) || header.vertexOffset + vertexBytes > header.indexOffset || header.indexOffset + indexBytes > size)
+		return false;
+	for (uint32_t i = 0; i < header.lodCount; i++)
+	{
+		if (static_cast<uint64_t>(header.lods[i].firstIndex) + header.lods[i].indexCount > header.indexCount)
+			return false;
+	}
+
+	view.vertices = data + header.vertexOffset;
+	view.vertexStride = header.vertexStride;
+	view.vertexCount = header.vertexCount;
+	view.indices = data + header.indexOffset;
+	view.indexSize = header.indexSize;
+	view.indexCount = header.indexCount;
+	view.lodCount = header.lodCount;
+	memcpy(view.lods, header.lods, sizeof(view.lods));
+	view.bounds = header.bounds;
+	return true;
+}
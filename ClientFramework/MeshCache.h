@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//바이너리 메쉬 캐시 (GPU, FBX SDK 없이 동작)
+//FBX를 읽고 LOD까지 만든 결과를 헤더 + 정점 덩어리 + 인덱스 덩어리로 저장한다.
+//덩어리는 공유 버퍼에 올릴 모양 그대로라 파일을 매핑한 주소에서 바로 업로드한다.
+//헤더의 소스 해시(FNV-1a)가 다르거나 버전, 정점 크기, LOD 수가 다르면 다시 만든다. 리틀 엔디안 기준
+//인덱스는 정점이 65536개 이하면 16비트, 넘으면 32비트로 저장한다.
+
+constexpr uint32_t MESH_CACHE_VERSION = 2;
+constexpr uint32_t MESH_CACHE_MAX_LOD = 8;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+struct MeshCacheLod
+{
+	uint32_t firstIndex; //인덱스 덩어리 안에서
+	uint32_t indexCount;
+};
+
+struct MeshCacheBounds
+{
+	float boxCenter[3];
+	float boxExtents[3];
+	float sphereCenter[3];
+	float sphereRadius;
+};
+
+struct MeshCacheHeader
+{
+	char magic[4]; //"MSHC"
+	uint32_t version;
+	uint64_t sourceHash;
+	uint32_t vertexStride;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t indexSize; //2 또는 4 (MeshIndexSize)
+	uint32_t reserved;
+	uint32_t lodCount;
+	MeshCacheLod lods[MESH_CACHE_MAX_LOD];
+	MeshCacheBounds bounds;
+	uint64_t vertexOffset; //파일 처음부터, 16바이트 정렬
+	uint64_t indexOffset;
+	uint64_t fileSize;
+};
+static_assert(sizeof(MeshCacheHeader) == 168, "mesh cache header layout changed, bump MESH_CACHE_VERSION");
+
+//캐시 파일 안을 가리키는 메쉬 (파일을 닫으면 무효)
+struct MeshCacheView
+{
+	const void* vertices = nullptr;
+	uint32_t vertexStride = 0;
+	uint32_t vertexCount = 0;
+	const void* indices = nullptr; //indexSize가 2면 uint16_t, 4면 uint32_t
+	uint32_t indexSize = 0;
+	uint32_t indexCount = 0;
+	uint32_t lodCount = 0;
+	MeshCacheLod lods[MESH_CACHE_MAX_LOD] = {};
+	MeshCacheBounds bounds = {};
+};
+
+//읽기 전용 파일 매핑 (Windows는 파일 매핑 객체, 그 외는 mmap)
+class MappedFile
+{
+public:
+	~MappedFile();
+
+	bool Open(const char* path);
+	void Close();
+
+	const uint8_t* _data = nullptr;
+	size_t _size = 0;
+
+private:
+	void* _file = nullptr; //Windows HANDLE
+	void* _mapping = nullptr;
+};
+
+//임시 파일에 쓰고 이름을 바꿔서, 읽는 쪽이 반쯤 쓴 파일을 보지 않게 함
+bool WriteFileAtomic(const char* path, const void* data, size_t size);
+
+//정점 수로 정하는 인덱스 크기 (바이트), 16비트로 모든 정점을 가리킬 수 있으면 2
+inline uint32_t MeshIndexSize(uint32_t vertexCount)
+{
+	return vertexCount <= 65536 ? 2 : 4;
+}
+
+uint64_t Fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS);
+//파일 전체의 FNV-1a, 읽을 수 없으면 0
+uint64_t HashFile(const char* path);
+
+//캐시 파일 내용을 메모리에 만듦 (에셋 팩에 그대로 넣음), 인덱스는 MeshIndexSize(vertexCount)로 줄여 저장
+//인덱스가 정점 범위를 벗어나면 false이고 out은 빔
+bool SerializeMeshCache(uint64_t sourceHash, const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+	const uint32_t* indices, uint32_t indexCount, const MeshCacheLod* lods, uint32_t lodCount, const MeshCacheBounds& bounds, std::vector<uint8_t>& out);
+//캐시 쓰기, 실패하면 false (다음 로드도 원본에서 읽을 뿐)
+bool WriteMeshCache(const char* path, uint64_t sourceHash, const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+	const uint32_t* indices, uint32_t indexCount, const MeshCacheLod* lods, uint32_t lodCount, const MeshCacheBounds& bounds);
+
+//매핑한 캐시(data, size)를 검사하고 view를 채움. sourceHash가 0이면 (원본이 없을 때) 해시는 보지 않음
+//data는 16바이트 정렬이어야 함 (파일 매핑 시작, 에셋 팩 항목 시작)
+bool ReadMeshCache(const uint8_t* data, size_t size, uint64_t sourceHash, uint32_t vertexStride, uint32_t lodCount, MeshCacheView& view);
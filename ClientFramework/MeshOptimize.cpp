@@ -0,0 +1,471 @@
+#include "MeshOptimize.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+
+namespace
+{
+	constexpr uint32_t EMPTY_SLOT = 0xffffffffu;
+
+	//정점 바이트 해시 (4바이트씩 섞고 마지막에 한 번 더 섞음)
+	uint32_t HashVertex(const uint8_t* bytes, size_t stride)
+	{
+		uint32_t hash = 2166136261u;
+		size_t i = 0;
+		for (; i + 4 <= stride; i += 4)
+		{
+			uint32_t word;
+			memcpy(&word, bytes + i, 4);
+			word *= 0xcc9e2d51u;
+			word = (word << 15) | (word >> 17);
+			hash ^= word * 0x1b873593u;
+			hash = ((hash << 13) | (hash >> 19)) * 5 + 0xe6546b64u;
+		}
+		for (; i < stride; i++)
+			hash = (hash ^ bytes[i]) * 16777619u;
+
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6bu;
+		hash ^= hash >> 13;
+		return hash;
+	}
+}
+
+size_t WeldVertices(const void* vertices, size_t stride, size_t vertexCount, std::vector<uint32_t>& remap)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+	remap.resize(vertexCount);
+
+	//열린 주소법 해시 테이블, 칸에는 처음 나온 정점의 원래 번호
+	size_t tableSize = 16;
+	while (tableSize < vertexCount * 2)
+		tableSize *= 2;
+	std::vector<uint32_t> table(tableSize, EMPTY_SLOT);
+
+	uint32_t uniqueCount = 0;
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const uint8_t* vertex = bytes + i * stride;
+		size_t slot = HashVertex(vertex, stride) & (tableSize - 1);
+		while (true)
+		{
+			uint32_t other = table[slot];
+			if (other == EMPTY_SLOT)
+			{
+				table[slot] = static_cast<uint32_t>(i);
+				remap[i] = uniqueCount++;
+				break;
+			}
+			if (memcmp(vertex, bytes + static_cast<size_t>(other) * stride, stride) == 0)
+			{
+				remap[i] = remap[other];
+				break;
+			}
+			slot = (slot + 1) & (tableSize - 1);
+		}
+	}
+	return uniqueCount;
+}
+
+void RemapVertices(void* dst, const void* vertices, size_t stride, size_t vertexCount, const std::vector<uint32_t>& remap)
+{
+	uint8_t* out = static_cast<uint8_t*>(dst);
+	const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+	for (size_t i = 0; i < vertexCount; i++)
+		memcpy(out + static_cast<size_t>(remap[i]) * stride, bytes + i * stride, stride);
+}
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+{
+	//FIFO 캐시, 정점마다 들어간 시각을 기록해 (지금 - 시각) < cacheSize면 캐시에 있음
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	std::vector<bool> used(vertexCount, false);
+	uint32_t time = cacheSize + 1;
+	size_t misses = 0, usedCount = 0;
+	for (uint32_t index : indices)
+	{
+		if (time - timestamps[index] > cacheSize)
+		{
+			timestamps[index] = time++;
+			misses++;
+		}
+		if (!used[index])
+		{
+			used[index] = true;
+			usedCount++;
+		}
+	}
+
+	VertexCacheStats stats;
+	size_t triCount = indices.size() / 3;
+	stats.acmr = triCount > 0 ? static_cast<float>(misses) / triCount : 0.0f;
+	stats.atvr = usedCount > 0 ? static_cast<float>(misses) / usedCount : 0.0f;
+	return stats;
+}
+
+namespace
+{
+	//Forsyth, "Linear-Speed Vertex Cache Optimisation"의 점수
+	constexpr int FORSYTH_CACHE_SIZE = 32;
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRI_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+	constexpr int MAX_VALENCE_SCORE = 32;
+
+	struct ForsythTables
+	{
+		float cache[FORSYTH_CACHE_SIZE];
+		float valence[MAX_VALENCE_SCORE];
+
+		ForsythTables()
+		{
+			for (int i = 0; i < FORSYTH_CACHE_SIZE; i++)
+			{
+				//방금 쓴 삼각형의 정점 3개는 같은 점수, 너무 높으면 같은 띠만 계속 따라감
+				if (i < 3)
+					cache[i] = LAST_TRI_SCORE;
+				else
+					cache[i] = powf(1.0f - static_cast<float>(i - 3) / (FORSYTH_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+			}
+			valence[0] = 0.0f;
+			for (int i = 1; i < MAX_VALENCE_SCORE; i++)
+				valence[i] = VALENCE_BOOST_SCALE * powf(static_cast<float>(i), -VALENCE_BOOST_POWER); //남은 삼각형이 적은 정점을 먼저 끝냄
+		}
+	};
+
+	float VertexScore(const ForsythTables& tables, int cachePosition, uint32_t remaining)
+	{
+		if (remaining == 0)
+			return -1.0f;
+		float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+		return score + tables.valence[std::min<uint32_t>(remaining, MAX_VALENCE_SCORE - 1)];
+	}
+}
+
+void OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& out)
+{
+	static const ForsythTables tables;
+	size_t triCount = indices.size() / 3;
+	out.clear();
+	out.reserve(triCount * 3);
+	if (triCount == 0)
+		return;
+
+	//정점 -> 삼각형 인접 목록 (CSR)
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (size_t i = 0; i < triCount * 3; i++)
+		remaining[indices[i]]++;
+	std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; v++)
+		adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+	std::vector<uint32_t> adjacency(triCount * 3);
+	std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+	for (size_t i = 0; i < triCount * 3; i++)
+		adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+		vertexScore[v] = VertexScore(tables, -1, remaining[v]);
+	std::vector<float> triScore(triCount);
+	std::vector<bool> emitted(triCount, false);
+	for (size_t t = 0; t < triCount; t++)
+		triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+	//삼각형을 뺀 정점은 인접 목록에서 앞으로 당겨 remaining개만 남김
+	auto removeTriangle = [&](uint32_t vertex, uint32_t tri) {
+		uint32_t* begin = &adjacency[adjacencyOffset[vertex]];
+		uint32_t* end = begin + remaining[vertex];
+		uint32_t* it = std::find(begin, end, tri);
+		*it = *(end - 1);
+		remaining[vertex]--;
+	};
+
+	uint32_t cache[FORSYTH_CACHE_SIZE + 3];
+	int cacheCount = 0;
+	size_t cursor = 0; //캐시에서 고를 삼각형이 없을 때 여기부터 안 그린 삼각형을 찾음
+	int64_t best = 0;
+	for (size_t t = 1; t < triCount; t++)
+	{
+		if (triScore[t] > triScore[best])
+			best = static_cast<int64_t>(t);
+	}
+
+	for (size_t emittedCount = 0; emittedCount < triCount; emittedCount++)
+	{
+		if (best < 0)
+		{
+			while (emitted[cursor])
+				cursor++;
+			best = static_cast<int64_t>(cursor);
+		}
+
+		uint32_t tri = static_cast<uint32_t>(best);
+		emitted[tri] = true;
+		const uint32_t* corner = &indices[tri * 3];
+		out.insert(out.end(), { corner[0], corner[1], corner[2] });
+
+		//새 캐시 = 이 삼각형 정점 3개 + 이전 캐시에서 겹치지 않는 것 (LRU)
+		uint32_t newCache[FORSYTH_CACHE_SIZE + 3];
+		int newCount = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			removeTriangle(corner[k], tri);
+			newCache[newCount++] = corner[k];
+		}
+		for (int i = 0; i < cacheCount; i++)
+		{
+			uint32_t v = cache[i];
+			if (v != corner[0] && v != corner[1] && v != corner[2])
+				newCache[newCount++] = v;
+		}
+
+		//밀려난 정점 포함 전부 점수를 다시 매기고, 그 정점들의 남은 삼각형 중 최고를 다음 후보로
+		best = -1;
+		float bestScore = -1.0f;
+		for (int i = 0; i < newCount; i++)
+		{
+			uint32_t v = newCache[i];
+			cachePosition[v] = i < FORSYTH_CACHE_SIZE ? i : -1;
+			vertexScore[v] = VertexScore(tables, cachePosition[v], remaining[v]);
+		}
+		for (int i = 0; i < newCount; i++)
+		{
+			uint32_t v = newCache[i];
+			for (uint32_t a = 0; a < remaining[v]; a++)
+			{
+				uint32_t t = adjacency[adjacencyOffset[v] + a];
+				const uint32_t* c = &indices[t * 3];
+				triScore[t] = vertexScore[c[0]] + vertexScore[c[1]] + vertexScore[c[2]];
+				if (triScore[t] > bestScore)
+				{
+					bestScore = triScore[t];
+					best = t;
+				}
+			}
+		}
+
+		cacheCount = std::min(newCount, FORSYTH_CACHE_SIZE);
+		memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+	}
+}
+
+void OptimizeOverdraw(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, float threshold, std::vector<uint32_t>& out)
+{
+	size_t triCount = indices.size() / 3;
+	auto position = [&](uint32_t v) { return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + v * stride); };
+
+	//덩어리 나누기 (Sander et al. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+	//1. 세 정점이 전부 캐시에서 빠지는 삼각형 = 캐시가 끊기는 곳 (hard)
+	//2. 그 안에서 빈 캐시로 시작해 지금까지의 ACMR이 hard 덩어리 ACMR * threshold 이하가 되는 곳마다 또 나눔 (soft)
+	//덩어리마다 빈 캐시에서 시작해도 ACMR이 threshold배 안쪽이라 순서를 바꿔도 캐시 효율이 크게 나빠지지 않음
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t time = VERTEX_CACHE_SIZE + 1;
+	auto countMisses = [&](size_t t) {
+		int misses = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t v = indices[t * 3 + k];
+			if (time - timestamps[v] > VERTEX_CACHE_SIZE)
+			{
+				timestamps[v] = time++;
+				misses++;
+			}
+		}
+		return misses;
+	};
+	auto flushCache = [&]() { time += VERTEX_CACHE_SIZE + 1; };
+
+	std::vector<size_t> hardStart;
+	for (size_t t = 0; t < triCount; t++)
+	{
+		if (countMisses(t) == 3 || t == 0)
+			hardStart.push_back(t);
+	}
+	hardStart.push_back(triCount);
+
+	std::vector<size_t> clusterStart;
+	for (size_t h = 0; h + 1 < hardStart.size(); h++)
+	{
+		size_t first = hardStart[h], last = hardStart[h + 1];
+		flushCache();
+		size_t hardMisses = 0;
+		for (size_t t = first; t < last; t++)
+			hardMisses += countMisses(t);
+		float target = static_cast<float>(hardMisses) / (last - first) * threshold;
+
+		flushCache();
+		size_t start = first, misses = 0;
+		clusterStart.push_back(first);
+		for (size_t t = first; t < last; t++)
+		{
+			misses += countMisses(t);
+			if (t + 1 < last && static_cast<float>(misses) / (t + 1 - start) <= target)
+			{
+				start = t + 1;
+				misses = 0;
+				clusterStart.push_back(start);
+				flushCache();
+			}
+		}
+	}
+	clusterStart.push_back(triCount);
+
+	//메쉬 중심 (삼각형 중심을 넓이로 평균)
+	struct Cluster
+	{
+		size_t first, last;
+		float centroid[3];
+		float normal[3];
+		float sortKey;
+	};
+	std::vector<Cluster> clusters(clusterStart.size() - 1);
+	double meshCentroid[3] = {}, meshArea = 0.0;
+	for (size_t c = 0; c < clusters.size(); c++)
+	{
+		Cluster& cluster = clusters[c];
+		cluster = { clusterStart[c], clusterStart[c + 1], {}, {}, 0.0f };
+		double centroid[3] = {}, normal[3] = {}, area = 0.0;
+		for (size_t t = cluster.first; t < cluster.last; t++)
+		{
+			const float* p0 = position(indices[t * 3]);
+			const float* p1 = position(indices[t * 3 + 1]);
+			const float* p2 = position(indices[t * 3 + 2]);
+			double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			double triArea = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5;
+			for (int k = 0; k < 3; k++)
+			{
+				centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0 * triArea;
+				normal[k] += n[k];
+			}
+			area += triArea;
+		}
+		for (int k = 0; k < 3; k++)
+		{
+			meshCentroid[k] += centroid[k];
+			cluster.centroid[k] = static_cast<float>(area > 0.0 ? centroid[k] / area : 0.0);
+		}
+		double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		for (int k = 0; k < 3; k++)
+			cluster.normal[k] = static_cast<float>(length > 0.0 ? normal[k] / length : 0.0);
+		meshArea += area;
+	}
+	for (int k = 0; k < 3; k++)
+		meshCentroid[k] = meshArea > 0.0 ? meshCentroid[k] / meshArea : 0.0;
+
+	//(덩어리 중심 - 메쉬 중심) . 덩어리 노멀이 클수록 바깥을 봄, 큰 것부터 그림
+	for (Cluster& cluster : clusters)
+	{
+		cluster.sortKey = 0.0f;
+		for (int k = 0; k < 3; k++)
+			cluster.sortKey += static_cast<float>((cluster.centroid[k] - meshCentroid[k]) * cluster.normal[k]);
+	}
+	std::vector<uint32_t> order(clusters.size());
+	for (size_t c = 0; c < order.size(); c++)
+		order[c] = static_cast<uint32_t>(c);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return clusters[a].sortKey > clusters[b].sortKey; });
+
+	out.clear();
+	out.reserve(indices.size());
+	for (uint32_t c : order)
+		out.insert(out.end(), indices.begin() + clusters[c].first * 3, indices.begin() + clusters[c].last * 3);
+
+	if (AnalyzeVertexCache(out, vertexCount).acmr > AnalyzeVertexCache(indices, vertexCount).acmr * threshold)
+		out = indices;
+}
+
+size_t OptimizeVertexFetch(void* vertices, size_t stride, size_t vertexCount, std::vector<uint32_t>& indices)
+{
+	std::vector<uint32_t> remap(vertexCount, EMPTY_SLOT);
+	uint32_t next = 0;
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == EMPTY_SLOT)
+			remap[index] = next++;
+		index = remap[index];
+	}
+
+	std::vector<uint8_t> copy(static_cast<const uint8_t*>(vertices), static_cast<const uint8_t*>(vertices) + vertexCount * stride);
+	uint8_t* out = static_cast<uint8_t*>(vertices);
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		if (remap[v] != EMPTY_SLOT)
+			memcpy(out + static_cast<size_t>(remap[v]) * stride, &copy[v * stride], stride);
+	}
+	return next;
+}
+
+void RunMeshOptimizeBenchmark(int gridSize)
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	//FBX에서 모은 모양처럼 삼각형마다 정점 3개 (위치, 노멀, UV = float 9개)
+	//8칸마다 UV 이음새를 넣어 같은 위치라도 합쳐지지 않는 정점을 만듦
+	const size_t floatsPerVertex = 9;
+	std::vector<float> corners;
+	corners.reserve(static_cast<size_t>(gridSize) * gridSize * 6 * floatsPerVertex);
+	auto addCorner = [&](int x, int y, bool seam) {
+		float height = 2.0f * sinf(x * 0.1f) * cosf(y * 0.13f);
+		float u = seam ? 1.0f : (x % 8) / 8.0f;
+		corners.insert(corners.end(), { static_cast<float>(x), height, static_cast<float>(y), 0.0f, 1.0f, 0.0f, u, y / 8.0f, 0.0f });
+	};
+	for (int y = 0; y < gridSize; y++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			bool seam = (x % 8) == 7; //오른쪽 변이 이음새
+			addCorner(x, y, false); addCorner(x, y + 1, false); addCorner(x + 1, y, seam);
+			addCorner(x + 1, y, seam); addCorner(x, y + 1, false); addCorner(x + 1, y + 1, seam);
+		}
+	}
+	size_t stride = sizeof(float) * floatsPerVertex;
+	size_t cornerCount = corners.size() / floatsPerVertex;
+
+	std::vector<uint32_t> remap;
+	auto t0 = clock::now();
+	size_t uniqueCount = WeldVertices(corners.data(), stride, cornerCount, remap);
+	std::vector<float> welded(uniqueCount * floatsPerVertex);
+	RemapVertices(welded.data(), corners.data(), stride, cornerCount, remap);
+	double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+	printf("Mesh optimize benchmark : %d triangles\n", gridSize * gridSize * 2);
+	printf("  Weld : %zu -> %zu vertices (%.1f%%) in %.2f ms (%.1f ns/vertex)\n", cornerCount, uniqueCount, 100.0 * uniqueCount / cornerCount, ms, ms * 1e6 / cornerCount);
+
+	//FBX 폴리곤 순서는 보통 캐시와 상관없으므로 삼각형을 섞어서 시작
+	std::vector<uint32_t> indices(remap.begin(), remap.end());
+	size_t triCount = indices.size() / 3;
+	uint32_t seed = 12345;
+	for (size_t t = triCount - 1; t > 0; t--)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		size_t other = seed % (t + 1);
+		for (int k = 0; k < 3; k++)
+			std::swap(indices[t * 3 + k], indices[other * 3 + k]);
+	}
+	VertexCacheStats before = AnalyzeVertexCache(indices, uniqueCount);
+
+	std::vector<uint32_t> cacheOrder, overdrawOrder;
+	t0 = clock::now();
+	OptimizeVertexCache(indices, uniqueCount, cacheOrder);
+	double cacheMs = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+	VertexCacheStats afterCache = AnalyzeVertexCache(cacheOrder, uniqueCount);
+
+	t0 = clock::now();
+	OptimizeOverdraw(welded.data(), stride, uniqueCount, cacheOrder, 1.05f, overdrawOrder);
+	double overdrawMs = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+	VertexCacheStats afterOverdraw = AnalyzeVertexCache(overdrawOrder, uniqueCount);
+
+	t0 = clock::now();
+	size_t fetchCount = OptimizeVertexFetch(welded.data(), stride, uniqueCount, overdrawOrder);
+	double fetchMs = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+	printf("  Shuffled       : ACMR %.3f, ATVR %.3f\n", before.acmr, before.atvr);
+	printf("  Vertex cache   : ACMR %.3f, ATVR %.3f in %.2f ms\n", afterCache.acmr, afterCache.atvr, cacheMs);
+	printf("  Overdraw       : ACMR %.3f, ATVR %.3f in %.2f ms\n", afterOverdraw.acmr, afterOverdraw.atvr, overdrawMs);
+	printf("  Vertex fetch   : %zu vertices in %.2f ms\n", fetchCount, fetchMs);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//메쉬 정리 (GPU 없이 동작)
+//FBX에서 모서리(폴리곤 정점)마다 모은 정점을 합쳐 정점 버퍼와 인덱스 버퍼를 줄이고,
+//굽는 단계에서 삼각형과 정점 순서를 GPU 정점 캐시, 오버드로우, 정점 읽기에 맞게 바꾼다.
+
+//바이트가 완전히 같은 정점을 하나로 합침, 합친 정점 수 반환
+//remap[i]는 i번 정점의 새 번호 (처음 나온 순서대로 0부터)
+size_t WeldVertices(const void* vertices, size_t stride, size_t vertexCount, std::vector<uint32_t>& remap);
+
+//remap대로 정점을 옮겨 uniqueCount개로 만듦 (dst는 uniqueCount * stride 바이트)
+void RemapVertices(void* dst, const void* vertices, size_t stride, size_t vertexCount, const std::vector<uint32_t>& remap);
+
+//정점 캐시 시뮬레이션 결과 (FIFO, 크기는 VERTEX_CACHE_SIZE)
+//ACMR: 삼각형당 정점 셰이더 실행 수 (0.5 ~ 3, 낮을수록 좋음)
+//ATVR: 쓰인 정점 하나당 실행 수 (1이 최선)
+struct VertexCacheStats
+{
+	float acmr = 0.0f;
+	float atvr = 0.0f;
+};
+
+constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = VERTEX_CACHE_SIZE);
+
+//정점 캐시에 맞게 삼각형 순서를 바꿈 (Forsyth), 삼각형 집합은 그대로
+void OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& out);
+
+//캐시 순서로 정리한 indices를 캐시가 끊기는 곳에서 덩어리로 나누고, 바깥을 보는 덩어리부터 그리도록 정렬
+//(앞쪽 면이 먼저 그려져 뒤쪽 픽셀은 깊이 테스트에서 빠짐). ACMR이 threshold배보다 나빠지면 indices 그대로
+void OptimizeOverdraw(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, float threshold, std::vector<uint32_t>& out);
+
+//정점을 indices에서 처음 쓰이는 순서로 옮기고 indices도 고침, 안 쓰는 정점은 버림. 남은 정점 수 반환
+size_t OptimizeVertexFetch(void* vertices, size_t stride, size_t vertexCount, std::vector<uint32_t>& indices);
+
+//CPU만 쓰는 메쉬 정리 비용 측정, 결과는 콘솔로 출력
+void RunMeshOptimizeBenchmark(int gridSize);
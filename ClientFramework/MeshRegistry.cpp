@@ -0,0 +1,32 @@
+#include "Device.h"
+#include "CmdQueue.h"
+#include "CopyQueue.h"
+#include "MeshRegistry.h"
+
+MeshHandle MeshRegistry::AddMesh(const GpuVertex* vertices, UINT vertexCount, const void* indices, UINT indexCount, const MeshLod* lods, const MeshBounds& bounds, shared_ptr<VertexBuffer> vertexBufferPtr, shared_ptr<IndexBuffer> indexBufferPtr, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<Device> devicePtr)
+{
+	assert(_meshes.size() < MAX_MESH_COUNT);
+
+	Mesh mesh;
+	mesh.baseVertex = vertexBufferPtr->AddVertices(vertices, vertexCount, copyQueuePtr, devicePtr);
+	mesh.vertexCount = vertexCount;
+	mesh.indexSize = indexBufferPtr->_indexSize;
+	assert(mesh.indexSize == 4 || vertexCount <= 65536);
+	UINT firstIndex = indexBufferPtr->AddIndices(indices, indexCount, copyQueuePtr, devicePtr); //LOD 전부 한 번에
+	for (int lod = 0; lod < MESH_LOD_COUNT; lod++)
+	{
+		assert(lods[lod].firstIndex + lods[lod].indexCount <= indexCount);
+		mesh.lods[lod].firstIndex = firstIndex + lods[lod].firstIndex;
+		mesh.lods[lod].indexCount = lods[lod].indexCount;
+	}
+	mesh.bounds = bounds;
+#if PACKED_VERTEX
+	float boxMin[3], boxSize[3];
+	PositionQuantizationRange(&bounds.box.Center.x, &bounds.box.Extents.x, boxMin, boxSize);
+	mesh.positionScale = XMFLOAT4(boxSize[0], boxSize[1], boxSize[2], 0.0f);
+	mesh.positionBias = XMFLOAT4(boxMin[0], boxMin[1], boxMin[2], 0.0f);
+#endif
+
+	_meshes.push_back(mesh);
+	return static_cast<MeshHandle>(_meshes.size() - 1);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Util.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+//메쉬 하나, 공유 정점/인덱스 버퍼 안의 위치만 가짐
+struct Mesh
+{
+	UINT baseVertex = 0; //BaseVertexLocation
+	UINT vertexCount = 0;
+	UINT indexSize = 4; //2면 16비트 인덱스 버퍼, 4면 32비트 인덱스 버퍼에 있음
+	MeshLod lods[MESH_LOD_COUNT]; //LOD별 StartIndexLocation, IndexCount
+	MeshBounds bounds;
+	//PACKED_VERTEX: 양자화한 위치를 되돌리는 값 (ObjectConstants로 넘김)
+	XMFLOAT4 positionScale = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+	XMFLOAT4 positionBias = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+};
+
+//메쉬 등록소, 메쉬는 번호(MeshHandle)로만 가리킨다.
+//정점과 인덱스는 공유 버퍼에 이어 붙이므로 메쉬마다 리소스를 따로 만들지 않고
+//버퍼 바인딩 한 번으로 모든 메쉬를 그릴 수 있다.
+class MeshRegistry
+{
+public:
+	vector<Mesh> _meshes;
+
+	//메쉬 등록, indices는 모든 LOD를 이어 붙인 것이고 lods(MESH_LOD_COUNT개)는 그 안의 범위
+	//indices는 indexBufferPtr의 인덱스 크기와 같아야 함 (정점이 65536개 이하면 16비트 버퍼)
+	//PACKED_VERTEX면 vertices는 bounds.box로 양자화되어 있어야 함
+	//업로드는 열려 있는 복사 큐 배치에 기록됨 (데이터는 바로 스테이징에 복사하므로 호출 뒤 해제해도 됨)
+	MeshHandle AddMesh(const GpuVertex* vertices, UINT vertexCount, const void* indices, UINT indexCount, const MeshLod* lods, const MeshBounds& bounds, shared_ptr<VertexBuffer> vertexBufferPtr, shared_ptr<IndexBuffer> indexBufferPtr, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<Device> devicePtr);
+
+	const Mesh& GetMesh(MeshHandle handle) const { return _meshes[handle]; }
+	UINT GetMeshCount() const { return static_cast<UINT>(_meshes.size()); }
+};
@@ -0,0 +1,369 @@
+#include "MeshSimplify.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+	//평면 거리 제곱의 합, v^T A v + 2 b.v + c
+	struct Quadric
+	{
+		double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+		double b0 = 0, b1 = 0, b2 = 0;
+		double c = 0;
+
+		//평면 ax + by + cz + d = 0, 가중치 w
+		void AddPlane(double a, double b, double cc, double d, double w)
+		{
+			a00 += w * a * a; a01 += w * a * b; a02 += w * a * cc;
+			a11 += w * b * b; a12 += w * b * cc; a22 += w * cc * cc;
+			b0 += w * a * d; b1 += w * b * d; b2 += w * cc * d;
+			c += w * d * d;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a01 += q.a01; a02 += q.a02;
+			a11 += q.a11; a12 += q.a12; a22 += q.a22;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+		}
+
+		double Error(const float* p) const
+		{
+			double x = p[0], y = p[1], z = p[2];
+			double e = x * (a00 * x + a01 * y + a02 * z)
+				+ y * (a01 * x + a11 * y + a12 * z)
+				+ z * (a02 * x + a12 * y + a22 * z)
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+			return e > 0.0 ? e : 0.0;
+		}
+	};
+
+	//간선 합치기 후보, from을 to 위치로 옮김
+	struct Collapse
+	{
+		float error;
+		uint32_t from;
+		uint32_t to;
+		uint32_t version; //만들 때의 from, to version 합, 다르면 오래된 후보
+
+		bool operator>(const Collapse& other) const { return error > other.error; }
+	};
+
+	void Cross(const float* a, const float* b, const float* c, float* n)
+	{
+		float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+		float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+		n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+
+	const float BOUNDARY_WEIGHT = 10.0f; //열린 가장자리가 안쪽으로 말려들지 않게
+}
+
+float SimplifyMesh(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, size_t targetIndexCount, std::vector<uint32_t>& out)
+{
+	auto pos = [&](uint32_t v) { return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + v * stride); };
+
+	//같은 위치의 정점을 하나로 (UV 이음새 때문에 나뉜 정점)
+	std::vector<uint32_t> weld(vertexCount);
+	{
+		struct Key { uint32_t x, y, z; bool operator==(const Key& k) const { return x == k.x && y == k.y && z == k.z; } };
+		struct KeyHash { size_t operator()(const Key& k) const { return (k.x * 73856093u) ^ (k.y * 19349663u) ^ (k.z * 83492791u); } };
+		std::unordered_map<Key, uint32_t, KeyHash> table;
+		table.reserve(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++)
+		{
+			Key key;
+			memcpy(&key, pos(v), sizeof(key));
+			weld[v] = table.emplace(key, v).first->second;
+		}
+	}
+
+	//찌그러지지 않은 삼각형만 (합친 정점 번호)
+	std::vector<uint32_t> tris;
+	std::vector<uint32_t> corners; //삼각형 꼭짓점의 원래 정점 번호 (UV 유지용)
+	tris.reserve(indices.size());
+	corners.reserve(indices.size());
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		uint32_t a = weld[indices[i]], b = weld[indices[i + 1]], c = weld[indices[i + 2]];
+		if (a == b || b == c || a == c)
+			continue;
+		tris.insert(tris.end(), { a, b, c });
+		corners.insert(corners.end(), { indices[i], indices[i + 1], indices[i + 2] });
+	}
+	size_t triCount = tris.size() / 3;
+	size_t liveCount = triCount;
+	size_t targetTriCount = targetIndexCount / 3;
+	if (liveCount <= targetTriCount)
+	{
+		out = corners;
+		return 0.0f;
+	}
+
+	//정점별 quadric, 인접 삼각형
+	std::vector<Quadric> quadrics(vertexCount);
+	std::vector<std::vector<uint32_t>> adjacency(vertexCount);
+	for (uint32_t t = 0; t < triCount; t++)
+	{
+		const uint32_t* tri = &tris[t * 3];
+		float n[3];
+		Cross(pos(tri[0]), pos(tri[1]), pos(tri[2]), n);
+		double len = sqrt(double(n[0]) * n[0] + double(n[1]) * n[1] + double(n[2]) * n[2]);
+		if (len > 0.0)
+		{
+			double a = n[0] / len, b = n[1] / len, c = n[2] / len;
+			const float* p = pos(tri[0]);
+			double d = -(a * p[0] + b * p[1] + c * p[2]);
+			double area = len * 0.5;
+			for (int k = 0; k < 3; k++)
+				quadrics[tri[k]].AddPlane(a, b, c, d, area);
+		}
+		for (int k = 0; k < 3; k++)
+			adjacency[tri[k]].push_back(t);
+	}
+
+	//한 삼각형만 쓰는 간선 = 가장자리, 간선을 지나고 면에 수직인 평면을 더함
+	auto isBoundary = [&](uint32_t a, uint32_t b)
+	{
+		int use = 0;
+		for (uint32_t t : adjacency[a])
+		{
+			const uint32_t* tri = &tris[t * 3];
+			if (tri[0] == b || tri[1] == b || tri[2] == b)
+				use++;
+		}
+		return use == 1;
+	};
+	std::vector<char> boundary(triCount * 3, 0); //삼각형 간선 k (k -> k + 1)가 가장자리인지
+	for (size_t t = 0; t < triCount; t++)
+	{
+		const uint32_t* tri = &tris[t * 3];
+		float n[3];
+		Cross(pos(tri[0]), pos(tri[1]), pos(tri[2]), n);
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t a = tri[k], b = tri[(k + 1) % 3];
+			if (!isBoundary(a, b))
+				continue;
+			boundary[t * 3 + k] = 1;
+			const float* pa = pos(a);
+			const float* pb = pos(b);
+			double e[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+			double m[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+			double len = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+			if (len <= 0.0)
+				continue;
+			m[0] /= len; m[1] /= len; m[2] /= len;
+			double d = -(m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2]);
+			double w = BOUNDARY_WEIGHT * (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+			quadrics[a].AddPlane(m[0], m[1], m[2], d, w);
+			quadrics[b].AddPlane(m[0], m[1], m[2], d, w);
+		}
+	}
+
+	std::vector<uint32_t> version(vertexCount, 0);
+	std::vector<char> removed(triCount, 0);
+	std::vector<uint32_t> collapsedTo(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++)
+		collapsedTo[v] = v;
+
+	//최소 힙 (오차가 작은 후보부터)
+	std::vector<Collapse> heap;
+	heap.reserve(triCount * 4);
+	auto makeCandidate = [&](uint32_t from, uint32_t to)
+	{
+		Quadric q = quadrics[from];
+		q.Add(quadrics[to]);
+		return Collapse{ static_cast<float>(q.Error(pos(to))), from, to, version[from] + version[to] };
+	};
+	auto pushCandidate = [&](uint32_t from, uint32_t to)
+	{
+		heap.push_back(makeCandidate(from, to));
+		std::push_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+	};
+
+	//안쪽 간선은 반대편 삼각형이 반대 방향을 넣어주므로 한 방향만, 가장자리는 양쪽 다
+	for (size_t t = 0; t < triCount; t++)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t a = tris[t * 3 + k], b = tris[t * 3 + (k + 1) % 3];
+			heap.push_back(makeCandidate(a, b));
+			if (boundary[t * 3 + k])
+				heap.push_back(makeCandidate(b, a));
+		}
+	}
+	std::make_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+
+	std::vector<uint32_t> neighbors;
+	float lastError = 0.0f;
+	while (liveCount > targetTriCount && !heap.empty())
+	{
+		std::pop_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+		Collapse collapse = heap.back();
+		heap.pop_back();
+
+		uint32_t from = collapse.from, to = collapse.to;
+		if (collapsedTo[from] != from || collapsedTo[to] != to || collapse.version != version[from] + version[to])
+			continue;
+
+		//from을 to로 옮겼을 때 뒤집히는 삼각형이 있으면 포기
+		bool flips = false;
+		for (uint32_t t : adjacency[from])
+		{
+			if (removed[t])
+				continue;
+			const uint32_t* tri = &tris[t * 3];
+			if (tri[0] == to || tri[1] == to || tri[2] == to)
+				continue;
+			const float* p[3] = { pos(tri[0]), pos(tri[1]), pos(tri[2]) };
+			float before[3], after[3];
+			Cross(p[0], p[1], p[2], before);
+			for (int k = 0; k < 3; k++)
+				if (tri[k] == from)
+					p[k] = pos(to);
+			Cross(p[0], p[1], p[2], after);
+			if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0f)
+			{
+				flips = true;
+				break;
+			}
+		}
+		if (flips)
+			continue;
+
+		//합치기
+		lastError = collapse.error;
+		collapsedTo[from] = to;
+		quadrics[to].Add(quadrics[from]);
+		version[to]++;
+		for (uint32_t t : adjacency[from])
+		{
+			if (removed[t])
+				continue;
+			uint32_t* tri = &tris[t * 3];
+			bool hasTo = tri[0] == to || tri[1] == to || tri[2] == to;
+			for (int k = 0; k < 3; k++)
+				if (tri[k] == from)
+					tri[k] = to;
+			if (hasTo)
+			{
+				removed[t] = 1;
+				liveCount--;
+			}
+			else
+				adjacency[to].push_back(t);
+		}
+		adjacency[from].clear();
+
+		//to의 quadric이 바뀌었으므로 to에 붙은 간선 후보만 다시 계산 (이웃 정점은 한 번씩)
+		//지워진 삼각형은 인접 목록에서도 정리
+		neighbors.clear();
+		std::vector<uint32_t>& around = adjacency[to];
+		around.erase(std::remove_if(around.begin(), around.end(), [&](uint32_t t) { return removed[t] != 0; }), around.end());
+		for (uint32_t t : around)
+		{
+			for (int k = 0; k < 3; k++)
+				if (tris[t * 3 + k] != to)
+					neighbors.push_back(tris[t * 3 + k]);
+		}
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+		for (uint32_t other : neighbors)
+		{
+			pushCandidate(to, other);
+			pushCandidate(other, to);
+		}
+	}
+
+	//원래 정점이 살아 있으면 그대로 (UV 유지), 합쳐졌으면 합쳐진 위치의 대표 정점
+	out.clear();
+	out.reserve(liveCount * 3);
+	for (size_t t = 0; t < triCount; t++)
+	{
+		if (removed[t])
+			continue;
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t corner = corners[t * 3 + k];
+			out.push_back(weld[corner] == tris[t * 3 + k] ? corner : tris[t * 3 + k]);
+		}
+	}
+	return lastError;
+}
+
+void BuildLodChain(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, int lodCount, float ratio, std::vector<std::vector<uint32_t>>& lods)
+{
+	lods.assign(lodCount, std::vector<uint32_t>());
+	if (lodCount <= 0)
+		return;
+
+	//0단계도 찌그러진 삼각형은 뺌
+	SimplifyMesh(positions, stride, vertexCount, indices, indices.size(), lods[0]);
+	for (int lod = 1; lod < lodCount; lod++)
+	{
+		size_t target = static_cast<size_t>(lods[lod - 1].size() / 3 * ratio) * 3;
+		SimplifyMesh(positions, stride, vertexCount, lods[lod - 1], target, lods[lod]);
+	}
+}
+
+float ScreenSize(float radius, float distance, float projScaleY)
+{
+	if (distance <= radius)
+		return 1.0f; //카메라가 구 안에 있음
+	return radius * projScaleY / distance;
+}
+
+int SelectLod(float screenSize, const float* thresholds, int lodCount)
+{
+	int lod = 0;
+	while (lod < lodCount - 1 && screenSize < thresholds[lod])
+		lod++;
+	return lod;
+}
+
+void RunSimplifyBenchmark(int gridSize)
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	//울퉁불퉁한 격자 (gridSize x gridSize 칸, 삼각형 2 * gridSize^2개)
+	int side = gridSize + 1;
+	std::vector<float> positions(side * side * 3);
+	for (int y = 0; y < side; y++)
+	{
+		for (int x = 0; x < side; x++)
+		{
+			float* p = &positions[(y * side + x) * 3];
+			p[0] = static_cast<float>(x);
+			p[1] = 2.0f * sinf(x * 0.1f) * cosf(y * 0.13f);
+			p[2] = static_cast<float>(y);
+		}
+	}
+	std::vector<uint32_t> indices;
+	indices.reserve(gridSize * gridSize * 6);
+	for (int y = 0; y < gridSize; y++)
+	{
+		for (int x = 0; x < gridSize; x++)
+		{
+			uint32_t i0 = y * side + x, i1 = i0 + 1, i2 = i0 + side, i3 = i2 + 1;
+			indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+		}
+	}
+
+	const int lodCount = 4;
+	std::vector<std::vector<uint32_t>> lods;
+	auto t0 = clock::now();
+	BuildLodChain(positions.data(), sizeof(float) * 3, positions.size() / 3, indices, lodCount, 0.5f, lods);
+	double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+	printf("Simplify benchmark : %d triangles, %d LODs in %.1f ms (%.1f ns/triangle)\n", gridSize * gridSize * 2, lodCount, ms, ms * 1e6 / (gridSize * gridSize * 2));
+	for (int lod = 0; lod < lodCount; lod++)
+		printf("  LOD %d : %zu triangles\n", lod, lods[lod].size() / 3);
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//메쉬 단순화 (Quadric Error Metrics, GPU 없이 동작)
+//정점은 그대로 두고 인덱스만 새로 만든다 (간선을 한쪽 끝 정점으로 합침).
+//그래서 LOD들은 정점 버퍼 하나를 같이 쓰고 인덱스 버퍼만 LOD마다 다르다.
+
+//indices를 targetIndexCount개 이하로 줄여 out에 씀, 마지막으로 합친 간선의 오차(거리 제곱) 반환
+//positions는 정점마다 float3, stride는 정점 간 바이트 수. 같은 위치의 정점은 하나로 보고 합침
+float SimplifyMesh(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, size_t targetIndexCount, std::vector<uint32_t>& out);
+
+//lods[0]은 원본(찌그러진 삼각형만 뺌), 이후 단계마다 삼각형을 ratio배로 줄임
+//더 줄일 수 없으면 앞 단계를 그대로 씀 (항상 lodCount개)
+void BuildLodChain(const float* positions, size_t stride, size_t vertexCount, const std::vector<uint32_t>& indices, int lodCount, float ratio, std::vector<std::vector<uint32_t>>& lods);
+
+//경계 구가 화면 절반 높이에서 차지하는 비율 (projScaleY는 투영 행렬 _22)
+float ScreenSize(float radius, float distance, float projScaleY);
+//thresholds는 lodCount - 1개, 내림차순. 화면 크기가 작을수록 큰 LOD 번호
+int SelectLod(float screenSize, const float* thresholds, int lodCount);
+
+//CPU만 쓰는 단순화 비용 측정, 결과는 콘솔로 출력
+void RunSimplifyBenchmark(int gridSize);
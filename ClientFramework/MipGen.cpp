@@ -0,0 +1,244 @@
+#include "MipGen.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <random>
+
+static bool IsSrgb(uint32_t format)
+{
+	return format == FORMAT_R8G8B8A8_UNORM_SRGB || format == FORMAT_B8G8R8A8_UNORM_SRGB || format == FORMAT_B8G8R8X8_UNORM_SRGB;
+}
+
+bool CanGenerateMips(uint32_t format)
+{
+	return format == FORMAT_R8G8B8A8_UNORM || format == FORMAT_B8G8R8A8_UNORM || format == FORMAT_B8G8R8X8_UNORM || IsSrgb(format);
+}
+
+//dst 한 행, 소스 두 행 (y0, y1)의 2x2 평균. x0부터 끝까지 (홀수 폭의 마지막 열은 한 열만 씀)
+static void DownsampleRowScalar(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth, uint8_t* dst, uint32_t dstWidth, uint32_t x0)
+{
+	for (uint32_t x = x0; x < dstWidth; x++)
+	{
+		uint32_t sx0 = std::min(2 * x, srcWidth - 1) * 4;
+		uint32_t sx1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+		for (int c = 0; c < 4; c++)
+			dst[x * 4 + c] = static_cast<uint8_t>((row0[sx0 + c] + row0[sx1 + c] + row1[sx0 + c] + row1[sx1 + c] + 2) >> 2);
+	}
+}
+
+//dst 4픽셀 = 소스 두 행의 8픽셀씩
+static uint32_t DownsampleRowSse(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth, uint8_t* dst, uint32_t dstWidth)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi16(2);
+	uint32_t x = 0;
+	for (; x + 4 <= dstWidth && 2 * x + 8 <= srcWidth; x += 4)
+	{
+		__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+		__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16));
+		__m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+		__m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16));
+
+		//세로 합, 16비트로 펼쳐서 (레지스터 하나에 2픽셀)
+		__m128i v01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+		__m128i v23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+		__m128i v45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+		__m128i v67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+		//가로 합, 짝수 픽셀끼리 모은 것 + 홀수 픽셀끼리 모은 것
+		__m128i d01 = _mm_add_epi16(_mm_unpacklo_epi64(v01, v23), _mm_unpackhi_epi64(v01, v23));
+		__m128i d23 = _mm_add_epi16(_mm_unpacklo_epi64(v45, v67), _mm_unpackhi_epi64(v45, v67));
+		d01 = _mm_srli_epi16(_mm_add_epi16(d01, round), 2);
+		d23 = _mm_srli_epi16(_mm_add_epi16(d23, round), 2);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(d01, d23));
+	}
+	return x;
+}
+
+struct SrgbTable
+{
+	float toLinear[256];
+	uint8_t toSrgb[4096]; //선형 값 * 4095
+
+	SrgbTable()
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			float c = i / 255.0f;
+			toLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+		}
+		for (int i = 0; i < 4096; i++)
+		{
+			float l = i / 4095.0f;
+			float c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+			toSrgb[i] = static_cast<uint8_t>(std::min(255.0f, c * 255.0f + 0.5f));
+		}
+	}
+};
+
+static void DownsampleRowSrgb(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth, uint8_t* dst, uint32_t dstWidth)
+{
+	static const SrgbTable table;
+	for (uint32_t x = 0; x < dstWidth; x++)
+	{
+		uint32_t sx0 = std::min(2 * x, srcWidth - 1) * 4;
+		uint32_t sx1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+		for (int c = 0; c < 3; c++)
+		{
+			float l = table.toLinear[row0[sx0 + c]] + table.toLinear[row0[sx1 + c]] + table.toLinear[row1[sx0 + c]] + table.toLinear[row1[sx1 + c]];
+			dst[x * 4 + c] = table.toSrgb[static_cast<int>(l * 0.25f * 4095.0f + 0.5f)];
+		}
+		dst[x * 4 + 3] = static_cast<uint8_t>((row0[sx0 + 3] + row0[sx1 + 3] + row1[sx0 + 3] + row1[sx1 + 3] + 2) >> 2); //알파는 선형
+	}
+}
+
+static void Downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint32_t srcPitch, uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, bool srgb, bool simd)
+{
+	for (uint32_t y = 0; y < dstHeight; y++)
+	{
+		const uint8_t* row0 = src + std::min(2 * y, srcHeight - 1) * srcPitch;
+		const uint8_t* row1 = src + std::min(2 * y + 1, srcHeight - 1) * srcPitch;
+		uint8_t* out = dst + y * dstWidth * 4;
+		if (srgb)
+			DownsampleRowSrgb(row0, row1, srcWidth, out, dstWidth);
+		else
+			DownsampleRowScalar(row0, row1, srcWidth, out, dstWidth, simd ? DownsampleRowSse(row0, row1, srcWidth, out, dstWidth) : 0);
+	}
+}
+
+static bool GenerateMipsImpl(TextureData& data, bool simd)
+{
+	if (data.mips.size() != 1 || !CanGenerateMips(data.format))
+		return false;
+
+	uint32_t mipCount = 1;
+	for (uint32_t size = std::max(data.width, data.height); size > 1; size >>= 1)
+		mipCount++;
+	if (mipCount == 1)
+		return false;
+
+	//밉마다 빈틈없이 (행 간격 = 폭 * 4)
+	std::vector<TextureMip> mips(mipCount);
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < mipCount; i++)
+	{
+		mips[i].offset = total;
+		mips[i].width = std::max(1u, data.width >> i);
+		mips[i].height = std::max(1u, data.height >> i);
+		mips[i].rowPitch = mips[i].width * 4;
+		mips[i].rowCount = mips[i].height;
+		total += static_cast<uint64_t>(mips[i].rowPitch) * mips[i].rowCount;
+	}
+
+	std::vector<uint8_t> pixels(total);
+	const TextureMip& top = data.mips[0];
+	for (uint32_t y = 0; y < mips[0].height; y++)
+		memcpy(&pixels[y * mips[0].rowPitch], &data.pixels[top.offset + y * top.rowPitch], mips[0].rowPitch);
+
+	bool srgb = IsSrgb(data.format);
+	for (uint32_t i = 1; i < mipCount; i++)
+	{
+		const TextureMip& src = mips[i - 1];
+		Downsample(&pixels[src.offset], src.width, src.height, src.rowPitch, &pixels[mips[i].offset], mips[i].width, mips[i].height, srgb, simd);
+	}
+
+	data.mips = std::move(mips);
+	data.pixels = std::move(pixels);
+	return true;
+}
+
+bool GenerateMips(TextureData& data)
+{
+	return GenerateMipsImpl(data, true);
+}
+
+bool IsBlockCompressed(uint32_t format)
+{
+	//DXGI_FORMAT_BC1_TYPELESS(70) ~ BC5_SNORM(84), BC6H_TYPELESS(94) ~ BC7_UNORM_SRGB(99)
+	return (format >= 70 && format <= 84) || (format >= 94 && format <= 99);
+}
+
+void DropTopMips(TextureData& data, uint32_t maxSize)
+{
+	bool blockCompressed = IsBlockCompressed(data.format);
+	size_t first = 0;
+	while (first + 1 < data.mips.size() && std::max(data.mips[first].width, data.mips[first].height) > maxSize)
+	{
+		const TextureMip& next = data.mips[first + 1];
+		if (blockCompressed && (next.width % 4 != 0 || next.height % 4 != 0))
+			break;
+		first++;
+	}
+	if (first == 0)
+		return;
+
+	//남은 밉을 앞으로 당기고 버린 만큼 메모리 반납
+	uint64_t base = data.mips[first].offset;
+	data.pixels.erase(data.pixels.begin(), data.pixels.begin() + static_cast<ptrdiff_t>(base));
+	data.pixels.shrink_to_fit();
+	data.mips.erase(data.mips.begin(), data.mips.begin() + static_cast<ptrdiff_t>(first));
+	for (TextureMip& mip : data.mips)
+		mip.offset -= base;
+	data.width = data.mips[0].width;
+	data.height = data.mips[0].height;
+}
+
+void RunMipBenchmark(int size)
+{
+	TextureData source;
+	source.width = size;
+	source.height = size;
+	source.format = FORMAT_R8G8B8A8_UNORM;
+	source.mips.push_back({ 0, source.width, source.height, source.width * 4, source.height });
+	source.pixels.resize(static_cast<size_t>(size) * size * 4);
+	std::mt19937 rng(7);
+	for (uint8_t& p : source.pixels)
+		p = static_cast<uint8_t>(rng());
+
+	auto run = [&](bool simd, TextureData& out) {
+		double best = 1e30;
+		for (int i = 0; i < 5; i++)
+		{
+			out = source;
+			auto start = std::chrono::high_resolution_clock::now();
+			GenerateMipsImpl(out, simd);
+			best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+		}
+		return best;
+	};
+
+	TextureData scalar, sse;
+	double scalarMs = run(false, scalar);
+	double sseMs = run(true, sse);
+	printf("mips %dx%d (%zu levels)\n", size, size, sse.mips.size());
+	printf("  scalar %.2f ms, sse %.2f ms (%.1fx), %s\n", scalarMs, sseMs, scalarMs / sseMs, scalar.pixels == sse.pixels ? "same result" : "MISMATCH");
+
+	source.format = FORMAT_R8G8B8A8_UNORM_SRGB;
+	TextureData srgb;
+	printf("  srgb   %.2f ms\n", run(true, srgb));
+
+	//BC1 1000x600을 256으로 줄이면 250x150 단계는 만들 수 없으므로 500x300에서 멈춰야 함
+	TextureData bc;
+	bc.format = 71; //DXGI_FORMAT_BC1_UNORM
+	uint64_t offset = 0;
+	for (uint32_t w = 1000, h = 600; ; w = std::max(w / 2, 1u), h = std::max(h / 2, 1u))
+	{
+		uint32_t blocksX = (w + 3) / 4, blocksY = (h + 3) / 4;
+		bc.mips.push_back({ offset, w, h, blocksX * 8, blocksY });
+		offset += static_cast<uint64_t>(blocksX) * 8 * blocksY;
+		if (w == 1 && h == 1)
+			break;
+	}
+	bc.pixels.resize(static_cast<size_t>(offset));
+	bc.width = 1000;
+	bc.height = 600;
+	DropTopMips(bc, 256);
+	bool blockAligned = bc.width % 4 == 0 && bc.height % 4 == 0;
+	printf("  bc1 1000x600 drop to 256 -> %ux%u, %s\n", bc.width, bc.height, blockAligned ? "block aligned" : "NOT BLOCK ALIGNED");
+	assert(blockAligned);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include "TextureStream.h"
+
+//밉 체인 생성 (GPU 없이 동작)
+//밉 0에서 시작해 2x2 박스 필터로 1x1까지 줄인다. 8비트 RGBA/BGRA만 다루고, UNORM은 SSE2로 4픽셀씩,
+//sRGB는 선형 공간으로 바꿔 평균낸 뒤 다시 sRGB로 바꾼다.
+
+//TextureData::format에 쓰는 DXGI_FORMAT 값 (dxgiformat.h 없이 쓰려고 필요한 것만)
+constexpr uint32_t FORMAT_R8G8B8A8_UNORM = 28;
+constexpr uint32_t FORMAT_R8G8B8A8_UNORM_SRGB = 29;
+constexpr uint32_t FORMAT_B8G8R8A8_UNORM = 87;
+constexpr uint32_t FORMAT_B8G8R8X8_UNORM = 88;
+constexpr uint32_t FORMAT_B8G8R8A8_UNORM_SRGB = 91;
+constexpr uint32_t FORMAT_B8G8R8X8_UNORM_SRGB = 93;
+
+//GenerateMips가 다루는 포맷인지
+bool CanGenerateMips(uint32_t format);
+
+//밉이 하나뿐이고 다룰 수 있는 포맷이면 전체 체인을 만들고 true (pixels는 밉마다 빈틈없이 다시 배치)
+bool GenerateMips(TextureData& data);
+
+//BC1~BC7 (4x4 블록 압축) 포맷인지
+bool IsBlockCompressed(uint32_t format);
+
+//maxSize보다 큰 밉을 버림 (최소 한 단계는 남김), 먼 오브젝트용 텍스처를 작게 상주시킬 때
+//블록 압축이면 새 밉 0의 너비와 높이가 4의 배수여야 텍스처를 만들 수 있으므로 그렇지 않은 단계 앞에서 멈춤
+void DropTopMips(TextureData& data, uint32_t maxSize);
+
+//CPU만 쓰는 밉 생성 비용 측정 (SSE와 스칼라 비교), 결과는 콘솔로 출력
+void RunMipBenchmark(int size);
@@ -4,22 +4,37 @@
 #include "PSO.h"
 void PSO::CreateInputLayoutAndPSOAndShader(shared_ptr<Device> devicePtr, shared_ptr<RootSignature> rootSignaturePtr, shared_ptr<DSV> dsvPtr)
 {
-	//̴ 
-	D3DCompileFromFile(L"..\\Shader.hlsl", nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "VS_Main", "vs_5_0", 0, 0, &_vsBlob, &_errBlob);
+	//셰이더 컴파일, 정점 모양은 Util.h의 PACKED_VERTEX를 따름
+	D3D_SHADER_MACRO macros[] =
+	{
+		{ "PACKED_VERTEX", PACKED_VERTEX ? "1" : "0" },
+		{ nullptr, nullptr },
+	};
+	D3DCompileFromFile(L"..\\Shader.hlsl", macros, D3D_COMPILE_STANDARD_FILE_INCLUDE, "VS_Main", "vs_5_1", 0, 0, &_vsBlob, &_errBlob);
 	_pipelineDesc.VS = { _vsBlob->GetBufferPointer(), _vsBlob->GetBufferSize() };
 
-	D3DCompileFromFile(L"..\\Shader.hlsl", nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "PS_Main", "ps_5_0", 0, 0, &_psBlob, &_errBlob);
+	D3DCompileFromFile(L"..\\Shader.hlsl", macros, D3D_COMPILE_STANDARD_FILE_INCLUDE, "PS_Main", "ps_5_1", 0, 0, &_psBlob, &_errBlob);
 	_pipelineDesc.PS = { _psBlob->GetBufferPointer(), _psBlob->GetBufferSize() };
 
-	//ǲ̾ƿ 
+	//인풋레이아웃 서술
+#if PACKED_VERTEX
+	//PackedVertex (16바이트)
+	D3D12_INPUT_ELEMENT_DESC desc[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+#else
 	D3D12_INPUT_ELEMENT_DESC desc[] =
 	{
 		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 28, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 	};
+#endif
 
-	//PSO   
+	//PSO 서술 및 생성
 	_pipelineDesc.InputLayout = { desc, _countof(desc) };
 	_pipelineDesc.pRootSignature = rootSignaturePtr->_signature.Get();
 
@@ -10,6 +10,6 @@ public:
 	ComPtr<ID3D12PipelineState> _pipelineState;
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC _pipelineDesc = {};
 
-	//ǲ̾ƿ PSO  ̴ 
+	//인풋레이아웃과 PSO생성 및 셰이더 컴파일
 	void CreateInputLayoutAndPSOAndShader(shared_ptr<Device> devicePtr, shared_ptr<RootSignature> rootSignaturePtr, shared_ptr<DSV> dsvPtr);
 };
\ No newline at end of file
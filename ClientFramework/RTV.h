@@ -7,6 +7,6 @@ public:
 	UINT							_rtvHeapSize = 0;
 	D3D12_CPU_DESCRIPTOR_HANDLE		_rtvHandle[2];
 
-	//RTV
+	//RTV생성
 	void CreateRTV(shared_ptr<Device> devicePtr, shared_ptr<SwapChain> swapChainPtr);
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "RenderThreads.h"
+
+RenderThreads::~RenderThreads()
+{
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		_quit = true;
+	}
+	_wakeCv.notify_all();
+	for (auto& t : _threads)
+		t.join();
+}
+
+void RenderThreads::Init(int threadCount)
+{
+	for (int i = 0; i < threadCount; i++)
+		_threads.emplace_back(&RenderThreads::WorkerMain, this);
+}
+
+void RenderThreads::Run(int jobCount, const std::function<void(int)>& job)
+{
+	if (jobCount <= 0)
+		return;
+
+	unsigned int generation;
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		_job = &job;
+		_jobCount = jobCount;
+		_nextJob = 0;
+		_remainJob = jobCount;
+		generation = ++_generation;
+	}
+	_wakeCv.notify_all();
+
+	RunJobs(generation);
+
+	std::unique_lock<std::mutex> guard(_lock);
+	_doneCv.wait(guard, [this] { return _remainJob == 0; });
+	_job = nullptr;
+}
+
+void RenderThreads::WorkerMain()
+{
+	unsigned int seen = 0;
+	while (true)
+	{
+		unsigned int generation;
+		{
+			std::unique_lock<std::mutex> guard(_lock);
+			_wakeCv.wait(guard, [&] { return _quit || _generation != seen; });
+			if (_quit)
+				return;
+			generation = seen = _generation;
+		}
+		RunJobs(generation);
+	}
+}
+
+void RenderThreads::RunJobs(unsigned int generation)
+{
+	while (true)
+	{
+		int index;
+		const std::function<void(int)>* job;
+		{
+			//작업을 꺼낼 때 세대를 확인하므로 늦게 깬 스레드가 끝난 Run의 작업을 잡지 않음
+			std::lock_guard<std::mutex> guard(_lock);
+			if (_generation != generation || _nextJob >= _jobCount)
+				return;
+			index = _nextJob++;
+			job = _job;
+		}
+
+		(*job)(index);
+
+		std::lock_guard<std::mutex> guard(_lock);
+		if (--_remainJob == 0)
+			_doneCv.notify_all();
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//커맨드 리스트 기록용 작업 스레드
+//Run(n, job)을 부르면 job(0) ~ job(n - 1)을 작업 스레드와 부른 스레드가 나눠서 실행하고, 모두 끝나면 반환
+class RenderThreads
+{
+public:
+	~RenderThreads();
+
+	//작업 스레드 생성 (부른 스레드도 같이 일하므로 전체 기록 스레드 수 - 1개)
+	void Init(int threadCount);
+
+	void Run(int jobCount, const std::function<void(int)>& job);
+
+private:
+	std::vector<std::thread>		_threads;
+	std::mutex						_lock;
+	std::condition_variable			_wakeCv;
+	std::condition_variable			_doneCv;
+
+	const std::function<void(int)>*	_job = nullptr;
+	int								_jobCount = 0;
+	int								_nextJob = 0;
+	int								_remainJob = 0;
+	unsigned int					_generation = 0; //Run마다 증가, 작업 스레드가 새 작업을 알아챔
+	bool							_quit = false;
+
+	void WorkerMain();
+	//현재 세대의 남은 작업을 하나씩 가져와 실행
+	void RunJobs(unsigned int generation);
+};
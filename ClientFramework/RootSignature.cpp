@@ -2,18 +2,21 @@
 #include "RootSignature.h"
 void RootSignature::CreateRootSignature(shared_ptr<Device> devicePtr)
 {
-	// ÷ 
+	//정적 샘플러 서술
 	_samplerDesc = CD3DX12_STATIC_SAMPLER_DESC(0);
 
-	//Ʈ Ű ũ ̺
+	//상수 버퍼는 루트 CBV로 주소만 넘기고, 디스크립터 테이블은 바인드리스 힙 전체 (크기 제한 없는 범위)
 	CD3DX12_DESCRIPTOR_RANGE ranges[] =
 	{
-		CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, CBV_REGISTER_COUNT, 0), //b0~b4
-		CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, SRV_REGISTER_COUNT, 0), //t0~t4
+		CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, 0), //t0~, Texture2D gTextures[]
 	};
 
-	CD3DX12_ROOT_PARAMETER param[1];
-	param[0].InitAsDescriptorTable(_countof(ranges), ranges);
+	CD3DX12_ROOT_PARAMETER param[ROOT_PARAM_COUNT];
+	param[ROOT_FRAME_CBV].InitAsConstantBufferView(0); //b0
+	param[ROOT_OBJECT_CBV].InitAsConstantBufferView(1); //b1
+	param[ROOT_SRV_TABLE].InitAsDescriptorTable(_countof(ranges), ranges, D3D12_SHADER_VISIBILITY_PIXEL);
+	param[ROOT_INSTANCES].InitAsShaderResourceView(0, 1, D3D12_SHADER_VISIBILITY_VERTEX); //t0, space1 : 인스턴스 버퍼
+	param[ROOT_INSTANCE_BASE].InitAsConstants(1, 0, 1, D3D12_SHADER_VISIBILITY_VERTEX); //b0, space1 : 인스턴스 시작 번호
 
 	D3D12_ROOT_SIGNATURE_DESC sigDesc = CD3DX12_ROOT_SIGNATURE_DESC(_countof(param), param, 1, &_samplerDesc);
 	sigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
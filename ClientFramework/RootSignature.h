@@ -1,11 +1,23 @@
 #pragma once
 #include "Util.h"
+
+//루트 매개변수 순서
+enum ROOT_PARAM
+{
+	ROOT_FRAME_CBV,		//b0 : 뷰, 투영, 조명 (프레임마다)
+	ROOT_OBJECT_CBV,	//b1 : 그리기마다
+	ROOT_SRV_TABLE,		//t0~ : 바인드리스 텍스처 테이블 (힙 전체)
+	ROOT_INSTANCES,		//t0, space1 : 인스턴스 버퍼
+	ROOT_INSTANCE_BASE,	//b0, space1 : 인스턴스 시작 번호
+	ROOT_PARAM_COUNT
+};
+
 class RootSignature
 {
 public:
 	ComPtr<ID3D12RootSignature>	_signature;
 	D3D12_STATIC_SAMPLER_DESC _samplerDesc;
 
-	//Ʈ ñ״ó 
+	//루트 시그니처 생성
 	void CreateRootSignature(shared_ptr<Device> devicePtr);
 };
\ No newline at end of file
@@ -1,32 +1,62 @@
 #pragma once
 #include "Util.h"
+#include "..\Server_work\PacketCapture.h"
+#include "..\Server_work\PacketDispatch.h"
 #include <iostream>
 
+class SFML;
+
+//패킷 핸들러가 받는 상태
+struct SFML_CONTEXT
+{
+	SFML* net;
+	Obj* playerArr;
+	Obj* npcArr;
+};
+
 class SFML
 {
 public:
 	sf::TcpSocket socket;
-	int myClientId;
+	int myClientId = 0; //서버가 준 내 로컬 핸들 (playerArr 인덱스)
+	CAPTURE_WRITER capture; //열려 있으면 받은 패킷을 파일로 기록
+	sf::IpAddress serverIp = "127.0.0.1";
 
-	void ConnectServer() // ӽ ִ κ
+	//이동 패킷 전용 UDP 채널, 로그인/추가/삭제는 계속 TCP
+	sf::UdpSocket udpSocket;
+	bool useUdp = true;
+	bool udpReady = false; //서버에서 SC_UDP_HELLO_OK를 받았는지
+	unsigned int udpToken = 0;
+	sf::Clock udpHelloClock;
+
+	//오브젝트별 마지막 이동 시퀀스, 이보다 오래된 이동 패킷은 버림
+	unsigned short lastMoveSeq[PLAYERMAX] = {};
+	bool moveSeqValid[PLAYERMAX] = {};
+	unsigned char viewGen[PLAYERMAX] = {}; //핸들의 현재 주인 세대 (SC_ADD_OBJECT, SC_LOGIN_OK), 다른 세대의 이동은 버림
+	vector<int> changedPlayers; //받은 패킷으로 바뀐 playerArr 번호, 그리는 쪽이 읽고 비움
+
+	void ConnectServer() //서버에 접속시 보내주는 부분
 	{
 		wcout.imbue(locale("korean"));
-		sf::Socket::Status status = socket.connect("127.0.0.1", PORT_NUM);
+		sf::Socket::Status status = socket.connect(serverIp, PORT_NUM);
 		socket.setBlocking(false);
 
 		if (status != sf::Socket::Done) {
-			wcout << L"   ϴ.\n";
+			wcout << L"서버와 연결할 수 없습니다.\n";
 			while (true);
 		}
 
-		CS_LOGIN_PACKET p;
-		p.size = sizeof(CS_LOGIN_PACKET);
-		p.type = CS_LOGIN;
+		if (useUdp) {
+			udpSocket.bind(sf::Socket::AnyPort);
+			udpSocket.setBlocking(false);
+		}
+
+		CS_LOGIN_PACKET p = make_packet<CS_LOGIN_PACKET>();
 		strcpy_s(p.name, "a");
-		send_packet(&p);
+		send_packet(p);
 	}
 
-	void ReceiveServer(Obj* playerArr, Obj* npcArr) // ޴°, clientMain
+	void ReceiveServer(Obj* playerArr, Obj* npcArr) //서버에서 받는거, clientMain
 	{
 		char net_buf[BUF_SIZE];
 		size_t	received;
@@ -34,97 +64,176 @@ public:
 		auto recv_result = socket.receive(net_buf, BUF_SIZE, received);
 		if (recv_result == sf::Socket::Error)
 		{
-			wcout << L"Recv !";
+			wcout << L"Recv 에러!";
 			while (true);
 		}
 		if (recv_result != sf::Socket::NotReady)
 			if (received > 0) process_data(net_buf, received, playerArr, npcArr);
+
+		if (useUdp) ReceiveUdp(playerArr, npcArr);
 	}
 
-	void process_data(char* net_buf, size_t io_byte, Obj* playerArr, Obj* npcArr)
+	void ReceiveUdp(Obj* playerArr, Obj* npcArr)
 	{
-		char* ptr = net_buf;
-		static size_t in_packet_size = 0;
-		static size_t saved_packet_size = 0;
-		static char packet_buffer[BUF_SIZE];
-
-		while (0 != io_byte) {
-			if (0 == in_packet_size) in_packet_size = ptr[0];
-			if (io_byte + saved_packet_size >= in_packet_size) {
-				memcpy(packet_buffer + saved_packet_size, ptr, in_packet_size - saved_packet_size);
-				ProcessPacket(packet_buffer, playerArr, npcArr);
-				ptr += in_packet_size - saved_packet_size;
-				io_byte -= in_packet_size - saved_packet_size;
-				in_packet_size = 0;
-				saved_packet_size = 0;
-			}
-			else {
-				memcpy(packet_buffer + saved_packet_size, ptr, io_byte);
-				saved_packet_size += io_byte;
-				io_byte = 0;
-			}
+		//등록 응답을 받을 때까지 0.5초마다 다시 보냄
+		if (!udpReady && udpToken != 0 && udpHelloClock.getElapsedTime().asSeconds() > 0.5f)
+			send_udp_hello();
+
+		//데이터그램 하나 = 패킷 하나
+		char udp_buf[BUF_SIZE];
+		size_t received;
+		sf::IpAddress sender;
+		unsigned short port;
+		while (udpSocket.receive(udp_buf, BUF_SIZE, received, sender, port) == sf::Socket::Done) {
+			if (sender != serverIp || port != PORT_NUM) continue;
+			if (received < 2 || static_cast<unsigned char>(udp_buf[0]) != received) continue;
+			if (capture.is_open()) capture.write(0, udp_buf);
+			ProcessPacket(udp_buf, playerArr, npcArr);
 		}
 	}
 
-	//  (Ŷ  ۾ Ұ ex: ̵ Ŷ, α Ŷ how to ó)
-	void ProcessPacket(char* ptr, Obj* playerArr, Obj* npcArr)
+	//받은 바이트를 이어 붙이고 완성된 패킷을 디스패처로 넘김, 정의는 클래스 아래
+	void process_data(char* net_buf, size_t io_byte, Obj* playerArr, Obj* npcArr);
+
+	//패킷 하나 처리 (UDP 데이터그램용)
+	void ProcessPacket(char* ptr, Obj* playerArr, Obj* npcArr);
+
+	//패킷 종류별 처리, opcode 테이블(g_sc_dispatcher)에 등록됨
+	static void OnLoginOk(SFML_CONTEXT& ctx, const SC_LOGIN_OK_PACKET& packet);
+	static void OnAddObject(SFML_CONTEXT& ctx, const SC_ADD_OBJECT_PACKET& packet);
+	static void OnMoveObject(SFML_CONTEXT& ctx, const SC_MOVE_OBJECT_PACKET* packets, int count);
+	static void OnRemoveObject(SFML_CONTEXT& ctx, const SC_REMOVE_OBJECT_PACKET& packet);
+	static void OnUdpHelloOk(SFML_CONTEXT& ctx, const SC_UDP_HELLO_OK_PACKET& packet);
+
+	//서버로 패킷 보내줄 때
+	template<class P>
+	void send_packet(const P& packet)
 	{
-		static bool first_time = true;
-		switch (ptr[1])
-		{
-		case SC_LOGIN_OK:
-		{
-			SC_LOGIN_OK_PACKET* packet = reinterpret_cast<SC_LOGIN_OK_PACKET*>(ptr);
-			myClientId = packet->id;
-			printf_s("%d\n", myClientId);
-			playerArr[myClientId].on = true;
-			playerArr[myClientId].transform.x = packet->x;
-			playerArr[myClientId].transform.y = packet->y;
-			playerArr[myClientId].transform.z = packet->z;
-
-			break;
-		}
-		case SC_ADD_OBJECT:
-		{
-			SC_ADD_OBJECT_PACKET* my_packet = reinterpret_cast<SC_ADD_OBJECT_PACKET*>(ptr);
-			int id = my_packet->id;
-			printf_s("%d\n", id);
-			if (id < PLAYERMAX) {
-				playerArr[id].on = true;
-				playerArr[id].transform.x = my_packet->x;
-				playerArr[id].transform.y = my_packet->y;
-				playerArr[id].transform.z = my_packet->z;
-			}
-
-			break;
-		}
-		case SC_MOVE_OBJECT:
-		{
-			SC_MOVE_OBJECT_PACKET* my_packet = reinterpret_cast<SC_MOVE_OBJECT_PACKET*>(ptr);
-			int id = my_packet->id;
-			playerArr[id].transform.x = my_packet->x;
-			playerArr[id].transform.y = my_packet->y;
-			playerArr[id].transform.z = my_packet->z;
-			//playerArr[id].rotate.y = my_packet->degree;
-			break;
-		}
-		case SC_REMOVE_OBJECT:
-		{
-			SC_REMOVE_OBJECT_PACKET* my_packet = reinterpret_cast<SC_REMOVE_OBJECT_PACKET*>(ptr);
-			int id = my_packet->id;
-			playerArr[id].on = false;
-			break;
-		}
-		default:
-			printf("Unknown PACKET type [%d]\n", ptr[1]);
-		}
+		char buf[wire_size<P>()];
+		int len = write_packet(packet, buf);
+		size_t sent = 0;
+		socket.send(buf, len, sent);
 	}
 
-	// Ŷ  
-	void send_packet(void* packet)
+	//로그인 때 받은 토큰으로 서버에 UDP 주소 등록
+	void send_udp_hello()
 	{
-		unsigned char* p = reinterpret_cast<unsigned char*>(packet);
-		size_t sent = 0;
-		socket.send(packet, p[0], sent);
+		char buf[wire_size<CS_UDP_HELLO_PACKET>()];
+		int len = emplace_packet<CS_UDP_HELLO_PACKET>(buf, udpToken);
+		udpSocket.send(buf, len, serverIp, PORT_NUM);
+		udpHelloClock.restart();
 	}
-};
\ No newline at end of file
+};
+
+inline void SFML::OnLoginOk(SFML_CONTEXT& ctx, const SC_LOGIN_OK_PACKET& packet)
+{
+	SFML& net = *ctx.net;
+	if (packet.id >= PLAYERMAX) return;
+	net.myClientId = packet.id;
+	printf_s("%d\n", net.myClientId);
+	ctx.playerArr[net.myClientId].on = true;
+	ctx.playerArr[net.myClientId].transform.x = packet.x;
+	ctx.playerArr[net.myClientId].transform.y = packet.y;
+	ctx.playerArr[net.myClientId].transform.z = packet.z;
+	net.moveSeqValid[net.myClientId] = false;
+	net.viewGen[net.myClientId] = packet.view_gen;
+	net.changedPlayers.push_back(net.myClientId);
+
+	net.udpToken = packet.udp_token;
+	if (net.useUdp) net.send_udp_hello();
+}
+
+inline void SFML::OnAddObject(SFML_CONTEXT& ctx, const SC_ADD_OBJECT_PACKET& packet)
+{
+	int id = packet.id;
+	printf_s("%d\n", id);
+	if (id >= PLAYERMAX) return;
+	ctx.playerArr[id].on = true;
+	ctx.playerArr[id].transform.x = packet.x;
+	ctx.playerArr[id].transform.y = packet.y;
+	ctx.playerArr[id].transform.z = packet.z;
+	ctx.net->moveSeqValid[id] = false;
+	ctx.net->viewGen[id] = packet.view_gen;
+	ctx.net->changedPlayers.push_back(id);
+}
+
+//한 번에 받은 이동 패킷 묶음, 오브젝트마다 시퀀스가 가장 최신인 것만 남음
+inline void SFML::OnMoveObject(SFML_CONTEXT& ctx, const SC_MOVE_OBJECT_PACKET* packets, int count)
+{
+	SFML& net = *ctx.net;
+	for (int i = 0; i < count; ++i) {
+		const SC_MOVE_OBJECT_PACKET& packet = packets[i];
+		int id = packet.id;
+		if (id >= PLAYERMAX) continue;
+		//핸들은 바로 다시 쓰이므로 이전 주인의 늦은 UDP 이동이나 ADD 전에 온 새 주인의 이동은 버림
+		if (!ctx.playerArr[id].on || packet.view_gen != net.viewGen[id]) continue;
+		//UDP는 순서가 뒤바뀌어 올 수 있으므로 이미 받은 것보다 오래된 이동은 무시
+		if (net.moveSeqValid[id] && static_cast<short>(packet.move_seq - net.lastMoveSeq[id]) <= 0) continue;
+		net.lastMoveSeq[id] = packet.move_seq;
+		net.moveSeqValid[id] = true;
+		ctx.playerArr[id].transform.x = packet.x;
+		ctx.playerArr[id].transform.y = packet.y;
+		ctx.playerArr[id].transform.z = packet.z;
+		//ctx.playerArr[id].rotate.y = packet.degree;
+		net.changedPlayers.push_back(id);
+	}
+}
+
+inline void SFML::OnRemoveObject(SFML_CONTEXT& ctx, const SC_REMOVE_OBJECT_PACKET& packet)
+{
+	int id = packet.id;
+	if (id >= PLAYERMAX) return;
+	ctx.playerArr[id].on = false;
+	ctx.net->moveSeqValid[id] = false;
+	ctx.net->changedPlayers.push_back(id);
+}
+
+inline void SFML::OnUdpHelloOk(SFML_CONTEXT& ctx, const SC_UDP_HELLO_OK_PACKET& packet)
+{
+	if (packet.udp_token == ctx.net->udpToken) ctx.net->udpReady = true;
+}
+
+//새 패킷은 핸들러를 만들고 여기에 한 줄 추가
+inline constexpr auto g_sc_dispatcher = make_dispatcher<SFML_CONTEXT>(SC_PACKET_SIZE,
+	ON_PACKET<SC_LOGIN_OK_PACKET, SFML::OnLoginOk>{},
+	ON_PACKET<SC_ADD_OBJECT_PACKET, SFML::OnAddObject>{},
+	ON_PACKET_BATCH<SC_MOVE_OBJECT_PACKET, SFML::OnMoveObject>{},
+	ON_PACKET<SC_REMOVE_OBJECT_PACKET, SFML::OnRemoveObject>{},
+	ON_PACKET<SC_UDP_HELLO_OK_PACKET, SFML::OnUdpHelloOk>{});
+
+inline void SFML::process_data(char* net_buf, size_t io_byte, Obj* playerArr, Obj* npcArr)
+{
+	//이전 recv에서 남은 조각 뒤에 이어 붙임 (조각은 패킷 하나보다 작음)
+	static char packet_buffer[BUF_SIZE * 2];
+	static int saved_packet_size = 0;
+
+	memcpy(packet_buffer + saved_packet_size, net_buf, io_byte);
+	int len = saved_packet_size + static_cast<int>(io_byte);
+
+	if (capture.is_open()) {
+		for (int offset = 0; offset < len; ) {
+			int packet_size = static_cast<unsigned char>(packet_buffer[offset]);
+			if (0 == packet_size || packet_size > len - offset) break;
+			capture.write(0, packet_buffer + offset);
+			offset += packet_size;
+		}
+	}
+
+	SFML_CONTEXT ctx{ this, playerArr, npcArr };
+	int used = dispatch_packets(g_sc_dispatcher, ctx, packet_buffer, len);
+	if (-1 == used) {
+		printf("Unknown PACKET type [%d]\n", packet_buffer[1]);
+		saved_packet_size = 0; //스트림이 깨졌으므로 버림
+		return;
+	}
+	saved_packet_size = len - used;
+	if (saved_packet_size > 0) memmove(packet_buffer, packet_buffer + used, saved_packet_size);
+}
+
+inline void SFML::ProcessPacket(char* ptr, Obj* playerArr, Obj* npcArr)
+{
+	SFML_CONTEXT ctx{ this, playerArr, npcArr };
+	int size = static_cast<unsigned char>(ptr[0]);
+	if (size != dispatch_packets(g_sc_dispatcher, ctx, ptr, size))
+		printf("Unknown PACKET type [%d]\n", ptr[1]);
+}
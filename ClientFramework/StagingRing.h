@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+//스테이징 링 버퍼의 영역 관리 (GPU 없이 동작)
+//업로드할 데이터를 링 버퍼 앞에서부터 잘라 쓰고, 배치를 제출할 때 펜스 값을 붙여 둔다.
+//GPU가 그 펜스를 지나면 그 배치가 쓴 영역을 한꺼번에 돌려받는다.
+//빈 공간은 항상 _head부터 이어져 있으므로 사용량만 세면 된다 (끝에 안 들어가면 0으로 넘어가고 남은 끝은 버림).
+class StagingRing
+{
+public:
+	static constexpr uint64_t INVALID_OFFSET = 0xFFFFFFFFFFFFFFFFull;
+
+	void Init(uint64_t capacity)
+	{
+		_capacity = capacity;
+		_head = 0;
+		_used = 0;
+		_pending = 0;
+		_batches.clear();
+	}
+
+	//size바이트를 align(2의 거듭제곱) 단위 위치에서 잘라 시작 위치 반환, 자리가 없으면 INVALID_OFFSET
+	uint64_t Allocate(uint64_t size, uint64_t align)
+	{
+		if (size == 0 || size > _capacity)
+			return INVALID_OFFSET;
+
+		uint64_t offset = (_head + align - 1) & ~(align - 1);
+		if (offset + size > _capacity)
+			offset = 0; //끝에 안 들어가면 처음으로
+		uint64_t consumed = (offset >= _head ? offset - _head : _capacity - _head) + size;
+		if (consumed > _capacity - _used)
+			return INVALID_OFFSET;
+
+		_head = offset + size;
+		if (_head == _capacity)
+			_head = 0;
+		_used += consumed;
+		_pending += consumed;
+		return offset;
+	}
+
+	//마지막 Commit 이후 잘라 준 영역을 fenceValue가 끝나면 돌려받도록 표시
+	void Commit(uint64_t fenceValue)
+	{
+		if (_pending == 0)
+			return;
+		_batches.push_back({ fenceValue, _pending });
+		_pending = 0;
+	}
+
+	//completedValue까지 끝난 배치의 영역 반환
+	void Retire(uint64_t completedValue)
+	{
+		while (!_batches.empty() && _batches.front().fenceValue <= completedValue)
+		{
+			_used -= _batches.front().size;
+			_batches.pop_front();
+		}
+		if (_used == 0)
+			_head = 0; //비었으면 처음부터 (끝에서 버리는 공간 줄이기)
+	}
+
+	//아직 돌려받지 못한 배치 중 가장 늦은 펜스 값, 없으면 0
+	uint64_t GetLastFenceValue() const { return _batches.empty() ? 0 : _batches.back().fenceValue; }
+	uint64_t GetUsedSize() const { return _used; }
+	uint64_t GetCapacity() const { return _capacity; }
+
+private:
+	struct Batch
+	{
+		uint64_t fenceValue;
+		uint64_t size;
+	};
+
+	uint64_t _capacity = 0;
+	uint64_t _head = 0; //다음에 자를 위치
+	uint64_t _used = 0; //돌려받지 못한 바이트 (버린 끝 포함)
+	uint64_t _pending = 0; //아직 Commit 안 한 바이트
+	std::deque<Batch> _batches;
+};
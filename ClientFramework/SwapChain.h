@@ -7,6 +7,6 @@ public:
 	ComPtr<ID3D12Resource> _renderTargets[2];
 	UINT _backBufferIndex = 0;
 
-	//ü   
+	//스왑체인 서술 및 생성
 	void DescriptAndCreateSwapChain(WindowInfo windowInfo, shared_ptr<Device> devicePtr, shared_ptr<CmdQueue> cmdQueuePtr);
 };
\ No newline at end of file
@@ -1,58 +1,176 @@
 #include "Device.h"
 #include "CmdQueue.h"
+#include "CopyQueue.h"
 #include "Texture.h"
+#include "MipGen.h"
+#include "BcEncode.h"
+#include "AssetPack.h"
+#include "AssetCook.h"
 
-void Texture::CreateTexture(const wstring& path, shared_ptr<Device> devicePtr, shared_ptr<CmdQueue> cmdQueuePtr)
+//밉까지 만든 텍스처를 BC로 압축하고 소스 옆에 DDS로 저장, 압축할 수 없으면 data 그대로
+static void BakeTexture(const wstring& path, TextureData& data)
 {
-	wstring ext = fs::path(path).extension();
+	if (!CompressTextureData(path, data))
+		return;
 
-	if (ext == L".dds" || ext == L".DDS") //dds
-		LoadFromDDSFile(path.c_str(), DDS_FLAGS_NONE, nullptr, _image);
-	else if (ext == L".tga" || ext == L".TGA") //tga
-		LoadFromTGAFile(path.c_str(), nullptr, _image);
-	else //png, jpg, jpeg, bmp
-		LoadFromWICFile(path.c_str(), WIC_FLAGS_NONE, nullptr, _image);
+	//캐시 저장은 실패해도 (읽기 전용 폴더 등) 이번 로드에는 압축한 것을 씀
+	if (!SaveDds(BakedTexturePath(path), data))
+		printf("texture bake: failed to write %ls\n", BakedTexturePath(path).c_str());
+}
 
-	HRESULT hr = ::CreateTexture(devicePtr->_device.Get(), _image.GetMetadata(), &_tex2D);
-	assert(SUCCEEDED(hr));
+//파일 -> TextureData, 디코드 스레드에서 불림
+//에셋 팩에 있으면 그것을, TEXTURE_BAKE면 소스보다 새 .bc.dds가 있을 때 그것을 읽고,
+//없으면 소스를 읽어 압축한 뒤 저장해 둠
+bool TextureStreamer::DecodeTexture(const wstring& path, TextureData& data)
+{
+	bool loaded = false;
+	//팩은 매핑만 하고 읽기만 하므로 디코드 스레드끼리 같이 써도 됨
+	const AssetPackEntry* entry = _assetPackPtr ? _assetPackPtr->Find(AssetNameFromPath(fs::path(path).string())) : nullptr;
+	if (entry && entry->type == ASSET_TEXTURE)
+		loaded = LoadDdsMemory(_assetPackPtr->GetData(*entry), static_cast<size_t>(entry->size), data);
 
-	vector<D3D12_SUBRESOURCE_DATA> subResources;
+#if TEXTURE_BAKE
+	if (!loaded)
+	{
+		wstring bakedPath = BakedTexturePath(path);
+		error_code ec;
+		//소스가 없으면 시간이 최소값이라 구운 것만 있어도 읽힘
+		if (fs::exists(bakedPath, ec) && fs::last_write_time(bakedPath, ec) >= fs::last_write_time(path, ec))
+			loaded = LoadDdsFile(bakedPath, data);
+	}
+#endif
 
-	hr = ::PrepareUpload(devicePtr->_device.Get(), _image.GetImages(), _image.GetImageCount(), _image.GetMetadata(), subResources);
+	if (!loaded)
+	{
+		if (!LoadTextureSource(path, data))
+			return false;
+#if TEXTURE_BAKE
+		BakeTexture(path, data);
+#endif
+	}
 
-	assert(SUCCEEDED(hr));
+	if (TEXTURE_MAX_RESIDENT_SIZE > 0)
+		DropTopMips(data, TEXTURE_MAX_RESIDENT_SIZE);
+	return true;
+}
 
-	const UINT bufferSize = ::GetRequiredIntermediateSize(_tex2D.Get(), 0, static_cast<UINT>(subResources.size()));
+bool Texture::CreateTexture(const TextureData& data, shared_ptr<Device> devicePtr)
+{
+	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(static_cast<DXGI_FORMAT>(data.format), data.width, data.height, 1, static_cast<UINT16>(data.mips.size()));
 
-	D3D12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+	HRESULT hr = devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&_tex2D));
+	if (FAILED(hr))
+	{
+		_tex2D = nullptr;
+		return false;
+	}
+	return true;
+}
 
-	ComPtr<ID3D12Resource> textureUploadHeap;
-	hr = devicePtr->_device->CreateCommittedResource(&heapProperty, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(textureUploadHeap.GetAddressOf()));
+void Texture::CreateSRV(shared_ptr<Device> devicePtr, shared_ptr<DescHeap> descHeapPtr)
+{
+	if (_srvIndex == DescriptorAllocator::INVALID_INDEX)
+		_srvIndex = descHeapPtr->AllocateIndex();
 
-	assert(SUCCEEDED(hr));
+	//SRV 서술
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Format = _tex2D->GetDesc().Format;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = _tex2D->GetDesc().MipLevels; //밉 전부
+	devicePtr->_device->CreateShaderResourceView(_tex2D.Get(), &srvDesc, descHeapPtr->GetCPUHandle(_srvIndex));
+}
+
+void TextureStreamer::CreateTextureStreamer(int threadCount, shared_ptr<Device> devicePtr, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<DescHeap> descHeapPtr, shared_ptr<AssetPack> assetPackPtr)
+{
+	_devicePtr = devicePtr;
+	_copyQueuePtr = copyQueuePtr;
+	_assetPackPtr = assetPackPtr;
+
+	//플레이스홀더, 4x4 회색 체크무늬
+	TextureData data;
+	data.width = 4;
+	data.height = 4;
+	data.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	data.mips.push_back({ 0, 4, 4, 4 * 4, 4 });
+	data.pixels.resize(4 * 4 * 4);
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			uint8_t gray = ((x + y) & 1) ? 96 : 160;
+			uint8_t* pixel = &data.pixels[(y * 4 + x) * 4];
+			pixel[0] = pixel[1] = pixel[2] = gray;
+			pixel[3] = 255;
+		}
+	}
 
-	UpdateSubresources(cmdQueuePtr->_resCmdList.Get(), _tex2D.Get(), textureUploadHeap.Get(), 0, 0, static_cast<unsigned int>(subResources.size()), subResources.data());
+	_placeholder->CreateTexture(data, devicePtr);
+	_copyQueuePtr->BeginBatch();
+	_copyQueuePtr->UploadTexture(_placeholder->_tex2D.Get(), data, devicePtr);
+	_copyQueuePtr->WaitFor(_copyQueuePtr->EndBatch(nullptr)); //초기화 때 한 번, 작음
+	_placeholder->CreateSRV(devicePtr, descHeapPtr);
+	_placeholder->_resident = true;
 
-	cmdQueuePtr->FlushResourceCommandQueue();
+	_stream.Init(threadCount, [this](const wstring& path, TextureData& data) { return DecodeTexture(path, data); });
 }
 
-void Texture::CreateSRV(shared_ptr<Device> devicePtr)
+shared_ptr<Texture> TextureStreamer::RequestTexture(const wstring& path)
 {
-	//SRVHeap 
-	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.NumDescriptors = 1;
-	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	devicePtr->_device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&_srvHeap));
+	shared_ptr<Texture> texture = make_shared<Texture>();
+	texture->_srvIndex = _placeholder->_srvIndex;
 
-	_srvHandle = _srvHeap->GetCPUDescriptorHandleForHeapStart();
+	uint32_t id = _stream.Request(path);
+	assert(id == _textures.size());
+	_textures.push_back(texture);
+	return texture;
+}
 
-	//SRV 
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Format = _image.GetMetadata().format;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Texture2D.MipLevels = 1;
-	devicePtr->_device->CreateShaderResourceView(_tex2D.Get(), &srvDesc, _srvHandle);
-}
\ No newline at end of file
+void TextureStreamer::Update(shared_ptr<DescHeap> descHeapPtr)
+{
+	_residentIds.clear();
+	_stream.Pump(*this, _residentIds);
+
+	for (uint32_t id : _residentIds)
+	{
+		//플레이스홀더 번호는 다른 텍스처도 쓰므로 새 번호를 받아 SRV 생성
+		//아직 GPU에 있는 이전 프레임은 플레이스홀더 번호를 그대로 읽음
+		shared_ptr<Texture>& texture = _textures[id];
+		texture->_srvIndex = DescriptorAllocator::INVALID_INDEX;
+		texture->CreateSRV(_devicePtr, descHeapPtr);
+		texture->_resident = true;
+	}
+}
+
+uint64_t TextureStreamer::CompletedValue()
+{
+	return _copyQueuePtr->CompletedValue();
+}
+
+void TextureStreamer::BeginBatch()
+{
+	_copyQueuePtr->BeginBatch();
+}
+
+TextureUploader::UPLOAD_RESULT TextureStreamer::Upload(uint32_t id, const TextureData& data)
+{
+	shared_ptr<Texture>& texture = _textures[id];
+	//만들 수 없으면 (지원하지 않는 포맷이나 크기) 플레이스홀더로 계속 그림
+	if (!texture->_tex2D && !texture->CreateTexture(data, _devicePtr))
+	{
+		printf("texture stream: failed to create %ux%u format %u texture, keeping the placeholder\n", data.width, data.height, data.format);
+		return UPLOAD_FAILED;
+	}
+
+	//COMMON에서 복사 큐가 COPY_DEST로, 끝나면 다시 COMMON으로 돌아가고
+	//그리기 큐에서 읽을 때 PIXEL_SHADER_RESOURCE로 자동 승격되므로 배리어가 필요 없음
+	return _copyQueuePtr->UploadTexture(texture->_tex2D.Get(), data, _devicePtr) ? UPLOADED : STAGING_FULL;
+}
+
+uint64_t TextureStreamer::EndBatch()
+{
+	//그리기 큐는 기다리지 않음, 펜스가 지난 것을 확인한 뒤에만 SRV를 바꿔 끼우므로
+	return _copyQueuePtr->EndBatch(nullptr);
+}
@@ -1,17 +1,57 @@
 #pragma once
 #include "Util.h"
+#include "DescHeap.h"
+#include "TextureStream.h"
+#include "AssetPack.h"
 class Texture
 {
 public:
-	ScratchImage _image;
 	ComPtr<ID3D12Resource> _tex2D;
 
-	ComPtr<ID3D12DescriptorHeap> _srvHeap;
-	D3D12_CPU_DESCRIPTOR_HANDLE	 _srvHandle;
+	//바인드리스 힙 안의 고정 번호, 텍스처가 없어질 때도 반납하지 않음 (텍스처는 프로그램이 끝날 때까지 살아 있음)
+	//반납을 넣을 때는 _resident인 텍스처만 자기 번호의 주인이고(플레이스홀더 번호는 공유),
+	//그 번호를 읽는 프레임이 모두 끝난 뒤에 FreeIndex해야 함
+	UINT _srvIndex = DescriptorAllocator::INVALID_INDEX;
+	bool _resident = false; //false면 _srvIndex는 플레이스홀더 번호
 
-	//ؽó ε  ε
-	void CreateTexture(const wstring& path, shared_ptr<Device> devicePtr, shared_ptr<CmdQueue> cmdQueuePtr);
+	//디코드된 데이터 크기대로 기본 힙 텍스처 생성 (COMMON 상태, 복사 큐가 채움), 실패하면 false
+	bool CreateTexture(const TextureData& data, shared_ptr<Device> devicePtr);
 
-	//SRV 
-	void CreateSRV(shared_ptr<Device> devicePtr);
-};
\ No newline at end of file
+	//바인드리스 힙에 번호를 받아 SRV 생성
+	void CreateSRV(shared_ptr<Device> devicePtr, shared_ptr<DescHeap> descHeapPtr);
+};
+
+//텍스처 스트리밍 (TextureStream의 D3D쪽)
+//요청한 텍스처는 상주할 때까지 작은 플레이스홀더의 SRV 번호를 쓰고,
+//업로드 배치의 펜스가 지나면 새 번호에 진짜 SRV를 만들어 _srvIndex를 바꿔 끼운다.
+class TextureStreamer : public TextureUploader
+{
+public:
+	TextureStream _stream;
+	shared_ptr<Texture> _placeholder = make_shared<Texture>();
+	vector<shared_ptr<Texture>> _textures; //스트림 번호 -> 텍스처
+	vector<uint32_t> _residentIds;
+
+	shared_ptr<Device> _devicePtr;
+	shared_ptr<CopyQueue> _copyQueuePtr;
+	shared_ptr<AssetPack> _assetPackPtr; //열려 있으면 낱개 파일보다 먼저 찾음
+
+	//디코드 스레드 생성, 플레이스홀더 업로드
+	void CreateTextureStreamer(int threadCount, shared_ptr<Device> devicePtr, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<DescHeap> descHeapPtr, shared_ptr<AssetPack> assetPackPtr);
+
+	//파일 로드 요청, 바로 플레이스홀더로 그릴 수 있는 텍스처 반환
+	shared_ptr<Texture> RequestTexture(const wstring& path);
+
+	//매 프레임 기록 전에 호출, 업로드 진행 및 상주한 텍스처의 SRV 교체
+	void Update(shared_ptr<DescHeap> descHeapPtr);
+
+	//TextureUploader
+	uint64_t CompletedValue() override;
+	void BeginBatch() override;
+	UPLOAD_RESULT Upload(uint32_t id, const TextureData& data) override;
+	uint64_t EndBatch() override;
+
+private:
+	//디코드 스레드에서 불림
+	bool DecodeTexture(const wstring& path, TextureData& data);
+};
@@ -0,0 +1,134 @@
+#include "TextureStream.h"
+
+TextureStream::~TextureStream()
+{
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		_quit = true;
+	}
+	_wakeCv.notify_all();
+	for (auto& t : _threads)
+		t.join();
+}
+
+void TextureStream::Init(int threadCount, DecodeFn decode)
+{
+	_decode = std::move(decode);
+	for (int i = 0; i < threadCount; i++)
+		_threads.emplace_back(&TextureStream::WorkerMain, this);
+}
+
+uint32_t TextureStream::Request(const std::wstring& path)
+{
+	uint32_t id;
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		id = static_cast<uint32_t>(_states.size());
+		_states.push_back(QUEUED);
+		_decodeQueue.push_back({ id, path });
+	}
+	_wakeCv.notify_one();
+	return id;
+}
+
+void TextureStream::Pump(TextureUploader& uploader, std::vector<uint32_t>& residentIds)
+{
+	//펜스가 지난 배치는 상주
+	uint64_t completed = uploader.CompletedValue();
+	while (!_batches.empty() && _batches.front().fenceValue <= completed)
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		for (uint32_t id : _batches.front().ids)
+		{
+			_states[id] = RESIDENT;
+			residentIds.push_back(id);
+		}
+		_batches.pop_front();
+	}
+
+	//이전 배치가 아직 GPU에 있으면 이번 프레임은 기다리지 않고 넘어감
+	if (!_batches.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		while (!_decoded.empty())
+		{
+			_uploadQueue.push_back(std::move(_decoded.front()));
+			_decoded.pop_front();
+		}
+	}
+	if (_uploadQueue.empty())
+		return;
+
+	Batch batch;
+	uploader.BeginBatch();
+	while (!_uploadQueue.empty())
+	{
+		Decoded& item = _uploadQueue.front();
+		TextureUploader::UPLOAD_RESULT result = uploader.Upload(item.id, item.data);
+		if (result == TextureUploader::STAGING_FULL)
+			break; //스테이징이 찼음, 나머지는 다음 배치로
+		if (result == TextureUploader::UPLOAD_FAILED)
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_states[item.id] = FAILED;
+		}
+		else
+			batch.ids.push_back(item.id);
+		_uploadQueue.pop_front(); //스테이징에 복사했으므로 CPU쪽 픽셀은 바로 해제
+	}
+	batch.fenceValue = uploader.EndBatch();
+
+	if (batch.ids.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		for (uint32_t id : batch.ids)
+			_states[id] = UPLOADING;
+	}
+	_batches.push_back(std::move(batch));
+}
+
+TextureStream::STATE TextureStream::GetState(uint32_t id)
+{
+	std::lock_guard<std::mutex> guard(_lock);
+	return _states[id];
+}
+
+bool TextureStream::IsIdle()
+{
+	std::lock_guard<std::mutex> guard(_lock);
+	return _decodeQueue.empty() && _decoding == 0 && _decoded.empty() && _uploadQueue.empty() && _batches.empty();
+}
+
+void TextureStream::WorkerMain()
+{
+	while (true)
+	{
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> guard(_lock);
+			_wakeCv.wait(guard, [this] { return _quit || !_decodeQueue.empty(); });
+			if (_quit)
+				return;
+			job = std::move(_decodeQueue.front());
+			_decodeQueue.pop_front();
+			_decoding++;
+		}
+
+		Decoded decoded;
+		decoded.id = job.id;
+		bool ok = _decode(job.path, decoded.data);
+
+		std::lock_guard<std::mutex> guard(_lock);
+		_decoding--;
+		if (ok)
+		{
+			_states[job.id] = DECODED;
+			_decoded.push_back(std::move(decoded));
+		}
+		else
+			_states[job.id] = FAILED;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//디코드된 텍스처 (GPU 없이 다루는 형태)
+//pixels 하나에 밉이 순서대로 들어 있고, 밉마다 시작 위치와 행 간격을 적어둠
+struct TextureMip
+{
+	uint64_t offset = 0; //pixels 안에서 시작 위치
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t rowPitch = 0; //행 하나의 바이트 수
+	uint32_t rowCount = 0; //행 수 (블록 압축이면 블록 행 수)
+};
+
+struct TextureData
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t format = 0; //DXGI_FORMAT
+	std::vector<TextureMip> mips;
+	std::vector<uint8_t> pixels;
+};
+
+//업로드 단계, D3D에서는 복사 큐가 맡고 테스트에서는 가짜로 바꿔 끼움
+class TextureUploader
+{
+public:
+	enum UPLOAD_RESULT { UPLOADED, STAGING_FULL, UPLOAD_FAILED };
+
+	virtual ~TextureUploader() = default;
+
+	//끝난 배치의 펜스 값 (막히지 않음)
+	virtual uint64_t CompletedValue() = 0;
+	virtual void BeginBatch() = 0;
+	//id번 텍스처 업로드 기록, 스테이징에 자리가 없으면 STAGING_FULL (다음 배치로 미룸)
+	//텍스처를 만들 수 없으면 UPLOAD_FAILED (FAILED가 되고 다시 시도하지 않음)
+	virtual UPLOAD_RESULT Upload(uint32_t id, const TextureData& data) = 0;
+	//배치 제출, 이 배치의 펜스 값 반환
+	virtual uint64_t EndBatch() = 0;
+};
+
+//텍스처 비동기 스트리밍
+//Request한 파일을 작업 스레드가 디코드하고, 렌더 스레드가 매 프레임 Pump를 불러
+//디코드가 끝난 것들을 배치 하나로 올린다. 배치의 펜스가 지나면 그 텍스처들이 상주 상태가 된다.
+//한 번에 배치 하나만 GPU에 올라가 있으므로 업로더는 할당자 하나를 계속 다시 쓸 수 있다.
+class TextureStream
+{
+public:
+	enum STATE { QUEUED, DECODED, UPLOADING, RESIDENT, FAILED };
+
+	//파일 -> TextureData, 실패하면 false (작업 스레드에서 불림)
+	using DecodeFn = std::function<bool(const std::wstring& path, TextureData& data)>;
+
+	~TextureStream();
+
+	void Init(int threadCount, DecodeFn decode);
+
+	//디코드 요청, 텍스처 번호 반환 (요청 순서대로 0, 1, 2 ...)
+	uint32_t Request(const std::wstring& path);
+
+	//렌더 스레드에서 매 프레임 호출
+	//끝난 배치의 텍스처 번호를 residentIds에 붙이고, 이전 배치가 끝났으면 디코드된 텍스처로 새 배치를 기록
+	void Pump(TextureUploader& uploader, std::vector<uint32_t>& residentIds);
+
+	STATE GetState(uint32_t id);
+	//요청한 텍스처가 모두 상주하거나 실패했으면 true
+	bool IsIdle();
+
+private:
+	struct DecodeJob
+	{
+		uint32_t id;
+		std::wstring path;
+	};
+	struct Decoded
+	{
+		uint32_t id;
+		TextureData data;
+	};
+	struct Batch
+	{
+		uint64_t fenceValue;
+		std::vector<uint32_t> ids;
+	};
+
+	std::vector<std::thread>		_threads;
+	std::mutex						_lock;
+	std::condition_variable			_wakeCv;
+	bool							_quit = false;
+	DecodeFn						_decode;
+
+	//_lock으로 보호
+	std::deque<DecodeJob>			_decodeQueue;
+	std::deque<Decoded>				_decoded;
+	std::vector<STATE>				_states;
+	int								_decoding = 0;
+
+	//렌더 스레드 전용
+	std::deque<Decoded>				_uploadQueue; //스테이징이 모자라 미룬 것 포함
+	std::deque<Batch>				_batches;
+
+	void WorkerMain();
+};
@@ -1,5 +1,5 @@
 #pragma once
-//̺귯
+//라이브러리
 #pragma warning(disable:4996)
 
 #include <Windows.h>
@@ -9,6 +9,7 @@
 #include <wrl.h>
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
+#include <DirectXCollision.h>
 #include <d3d12.h>
 #include "d3dx12.h"
 #include <DirectXColors.h>
@@ -19,6 +20,7 @@
 
 #include "DirectXTex.h"
 #include "DirectXTex.inl"
+#include "VertexPack.h"
 
 #pragma region sfml
 #define SFML_STATIC 1
@@ -46,7 +48,7 @@
 #pragma comment (lib, "ws2_32.lib")
 
 #define CHARACTERINDEX 0
-#define PLAYERMAX 3
+#define PLAYERMAX 10 //서버가 주는 로컬 핸들 범위(MAX_VIEW)와 같음
 #define NPCMAX 10
 #pragma endregion
 
@@ -60,18 +62,34 @@
 #pragma comment (lib, "D3D12.lib")
 #pragma comment (lib, "dxgi.lib")
 
-//ӽ̽
+//네임스페이스
 using namespace std;
 using namespace DirectX;
 using namespace Microsoft::WRL;
 namespace fs = std::filesystem;
 
 #define SWAP_CHAIN_BUFFER_COUNT 2
-#define CBV_REGISTER_COUNT 5
-#define SRV_REGISTER_COUNT 5
-#define REGISTER_COUNT 10
-
-//
+#define FRAME_COUNT 2 //동시에 GPU에 올라가 있을 수 있는 프레임 수
+#define RECORD_THREAD_COUNT 4 //그리기 커맨드를 기록하는 스레드 수 (메인 스레드 포함)
+#define RECORD_CHUNK_MIN 8 //스레드 하나에 맡길 최소 그리기 수
+#define BINDLESS_SRV_COUNT 1024 //바인드리스 힙 크기 (텍스처 수 상한)
+#define GPU_CULLING 0 //1이면 컬링과 그리기 인자 작성을 컴퓨트 셰이더 + ExecuteIndirect로
+#define MESH_LOD_COUNT 4 //메쉬마다 만드는 LOD 수 (0이 원본)
+#define LOD_REDUCTION 0.5f //LOD 한 단계마다 남길 삼각형 비율
+#define MESH_OVERDRAW_THRESHOLD 1.05f //오버드로우 순서로 바꿀 때 허용하는 ACMR 악화 비율
+#define PACKED_VERTEX 0 //1이면 정점을 16바이트로 양자화해 올림 (위치 16비트, 노멀 8면체 2x16비트, UV half)
+#define MAX_MESH_COUNT 16 //등록할 수 있는 메쉬 수
+#define MESH_VERTEX_CAPACITY (1 << 20) //공유 정점 버퍼 크기 (정점 수)
+#define MESH_INDEX_CAPACITY (1 << 22) //공유 16비트 인덱스 버퍼 크기 (인덱스 수)
+#define MESH_INDEX32_CAPACITY (1 << 21) //정점이 65536개를 넘는 메쉬용 32비트 인덱스 버퍼 크기
+#define STAGING_BUFFER_SIZE (32 * 1024 * 1024) //복사 큐 스테이징 링 크기
+#define TEXTURE_DECODE_THREAD_COUNT 2 //텍스처 디코드 스레드 수
+#define TEXTURE_MAX_RESIDENT_SIZE 0 //0이면 밉 전부 상주, 아니면 이 크기보다 큰 밉은 올리지 않음
+#define TEXTURE_BAKE 1 //텍스처를 BC로 압축해 소스 옆에 .bc.dds로 캐시하고 다음부터 그것을 읽음
+#define TEXTURE_BAKE_BC7 0 //1이면 색 텍스처는 BC1/BC3 대신 BC7 (DirectXTex, 굽는 시간이 김)
+#define ASSET_PACK_PATH "../Resources/Assets.pak" //AssetCooker가 만드는 에셋 팩, 있으면 메쉬와 텍스처를 여기서 먼저 찾음
+
+//조명정보
 #define MAX_LIGHTS			16 
 
 #define POINT_LIGHT			1
@@ -104,14 +122,14 @@ struct LIGHTS
 
 struct LightInfo
 {
-	//float4  float4 ϸ е  ä ʿ䰡 
+	//float4인 이유는 float4로 선언하면 패딩값을 일일이 채울 필요가 없어서
 	XMFLOAT4 diffuse = XMFLOAT4(0.8f, 0.8f, 0.8f, 0.f);
 	XMFLOAT4 ambient = XMFLOAT4(0.2f, 0.2f, 0.2f, 0.f);
 	XMFLOAT4 specular = XMFLOAT4(0.5f, 0.5f, 0.5f, 0.f);
 	XMFLOAT4 direction = XMFLOAT4(-1.f, -1.f, 1.f, 0.f);
 };
 
-// ü
+//정점 구조체
 struct Vertex
 {
 	XMFLOAT3 pos;
@@ -119,7 +137,35 @@ struct Vertex
 	XMFLOAT2 uv;
 };
 
-// ķ ʱȭ
+//정점 버퍼에 올라가는 정점, PSO 인풋 레이아웃과 같음
+#if PACKED_VERTEX
+typedef PackedVertex GpuVertex;
+#else
+typedef Vertex GpuVertex;
+#endif
+
+//메쉬 경계 (로컬 좌표), 로드할 때 계산
+struct MeshBounds
+{
+	BoundingBox box;
+	BoundingSphere sphere;
+};
+
+//MeshRegistry에 등록된 메쉬 번호
+typedef UINT MeshHandle;
+constexpr MeshHandle INVALID_MESH_HANDLE = 0xffffffff; //LoadMesh 실패, 이 메쉬를 쓰는 오브젝트는 그리지 않음
+
+//LOD 하나가 인덱스 버퍼에서 차지하는 범위
+struct MeshLod
+{
+	UINT firstIndex = 0;
+	UINT indexCount = 0;
+};
+
+//화면 크기(경계 구 반지름 / 화면 절반 높이)가 이보다 작으면 다음 LOD
+constexpr float LOD_SCREEN_SIZE[MESH_LOD_COUNT - 1] = { 0.4f, 0.2f, 0.1f };
+
+//행렬을 단위행렬로 초기화
 static XMFLOAT4X4 Identity4x4()
 {
 	static XMFLOAT4X4 I(
@@ -131,22 +177,41 @@ static XMFLOAT4X4 Identity4x4()
 	return I;
 }
 
-//۷ Ѱ ü 
-struct Constants
+//상수버퍼로 넘겨줄 구조체의 형태
+//프레임마다 한 번 (b0)
+struct FrameConstants
 {
-	XMFLOAT4X4 world = Identity4x4();
 	XMFLOAT4X4 view = Identity4x4();
 	XMFLOAT4X4 proj = Identity4x4();
 	LightInfo lnghtInfo;
 };
 
+//그리기마다 (b1), 월드 행렬은 인스턴스 버퍼에 있음
+struct ObjectConstants
+{
+	XMFLOAT4 offset = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+	UINT textureIndex = 0; //재질 텍스처의 바인드리스 힙 번호
+	UINT padding[3] = {};
+	//PACKED_VERTEX: 위치 = bias + UNORM 위치 * scale (메쉬 AABB)
+	XMFLOAT4 positionScale = XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f);
+	XMFLOAT4 positionBias = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+};
+
+//인스턴스별 데이터, 셰이더의 StructuredBuffer<InstanceData>와 같은 배치
+struct InstanceData
+{
+	XMFLOAT4X4 world = Identity4x4();
+};
+
 struct Obj
 {
 	bool on = false;
 	XMFLOAT4 transform = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+	MeshHandle mesh = 0; //그릴 메쉬
+	float scale = 1.0f;
 };
 
-// õ 
+//윈도우와 관련된 정보
 struct WindowInfo {
 	HWND hwnd;
 	int ClientWidth = 600;
@@ -154,65 +219,8 @@ struct WindowInfo {
 };
 
 //SFML
-constexpr int PORT_NUM = 4000;
-constexpr int BUF_SIZE = 200;
-constexpr int NAME_SIZE = 20;
-
-constexpr int MAX_USER = 10;
-
-// Packet ID
-constexpr char CS_LOGIN = 0;
-constexpr char CS_MOVE = 1;
-
-constexpr char SC_LOGIN_OK = 11;
-constexpr char SC_ADD_OBJECT = 12;
-constexpr char SC_REMOVE_OBJECT = 13;
-constexpr char SC_MOVE_OBJECT = 14;
-
-#pragma pack (push, 1)
-struct CS_LOGIN_PACKET {
-	unsigned char size;
-	char	type;
-	char	name[NAME_SIZE];
-};
-
-struct CS_MOVE_PACKET {
-	unsigned char size;
-	char	type;
-	float	degree;
-	float	x;
-	float	y;
-	float	z;
-	unsigned  client_time;
-};
-
-struct SC_LOGIN_OK_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-	float	x, y, z;
-};
-
-struct SC_ADD_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int		id;
-	float	x, y, z;
-	char	name[NAME_SIZE];
-};
-
-struct SC_REMOVE_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-};
-
-struct SC_MOVE_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-	float	x, y, z, degree;
-	unsigned int client_time;
-};
+//패킷 정의는 서버와 같은 파일 하나만 사용 (스키마가 레이아웃을 컴파일 타임에 검사)
+#include "..\Server_work\protocol.h"
+#include "..\Server_work\PacketSchema.h"
 
-#pragma pack (pop)
\ No newline at end of file
+static_assert(PLAYERMAX >= MAX_VIEW, "playerArr must cover every local handle");
\ No newline at end of file
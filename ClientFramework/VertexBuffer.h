@@ -1,16 +1,18 @@
 #pragma once
 #include "Util.h"
 
+//모든 메쉬가 같이 쓰는 정점 버퍼 (기본 힙), 메쉬마다 앞에서부터 잘라 씀
 class VertexBuffer
 {
 public:
 	ComPtr<ID3D12Resource> _vertexBuffer;
 	D3D12_VERTEX_BUFFER_VIEW _vertexBufferView = {};
-	ComPtr<ID3D12Resource> _npcVertexBuffer;
-	D3D12_VERTEX_BUFFER_VIEW _npcVertexBufferView = {};
-	UINT _vertexCount = 0;
-	Constants _transform = {};
+	UINT _capacity = 0; //정점 수
+	UINT _vertexCount = 0; //지금까지 쓴 정점 수
+	FrameConstants _transform = {};
 
-	//ؽ  
-	void CreateVertexBuffer(const vector<Vertex>& buffer, shared_ptr<Device> devicePtr, int isPlayer); //isPlayer : ÷̾ ε  npcε , ߿ modelindexε     ְ int ص
-};
\ No newline at end of file
+	//버텍스 버퍼 생성 (capacity개 정점)
+	void CreateVertexBuffer(UINT capacity, shared_ptr<Device> devicePtr);
+	//정점 추가 (복사 큐 배치에 기록), 시작 정점 번호(BaseVertexLocation) 반환
+	UINT AddVertices(const GpuVertex* vertices, UINT count, shared_ptr<CopyQueue> copyQueuePtr, shared_ptr<Device> devicePtr);
+};
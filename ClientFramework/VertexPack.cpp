@@ -0,0 +1,208 @@
+#include "VertexPack.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+uint16_t FloatToHalf(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, 4);
+	uint32_t sign = (bits >> 16) & 0x8000u;
+	uint32_t exponent = (bits >> 23) & 0xffu;
+	uint32_t mantissa = bits & 0x7fffffu;
+
+	if (exponent == 0xffu) //inf, NaN
+		return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+
+	int halfExponent = static_cast<int>(exponent) - 127 + 15;
+	if (halfExponent >= 31) //half로 표현할 수 없이 큼
+		return static_cast<uint16_t>(sign | 0x7c00u);
+
+	if (halfExponent <= 0) //half 비정규수 또는 0
+	{
+		if (halfExponent < -10)
+			return static_cast<uint16_t>(sign);
+		mantissa |= 0x800000u;
+		uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+		uint32_t half = mantissa >> shift;
+		uint32_t rest = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (rest > halfway || (rest == halfway && (half & 1u))) //가까운 짝수로 반올림
+			half++;
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+	uint32_t rest = mantissa & 0x1fffu;
+	if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+		half++; //올림이 지수로 넘어가면 다음 지수 (최대면 inf)가 됨
+	return static_cast<uint16_t>(sign | half);
+}
+
+float HalfToFloat(uint16_t half)
+{
+	uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+	uint32_t exponent = (half >> 10) & 0x1fu;
+	uint32_t mantissa = half & 0x3ffu;
+
+	uint32_t bits;
+	if (exponent == 0x1fu)
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	else if (exponent != 0)
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	else if (mantissa == 0)
+		bits = sign;
+	else
+	{
+		//비정규수는 float에서는 정규수
+		int shift = 0;
+		while ((mantissa & 0x400u) == 0)
+		{
+			mantissa <<= 1;
+			shift++;
+		}
+		bits = sign | (static_cast<uint32_t>(127 - 15 + 1 - shift) << 23) | ((mantissa & 0x3ffu) << 13);
+	}
+
+	float value;
+	memcpy(&value, &bits, 4);
+	return value;
+}
+
+static int16_t ToSnorm16(float value)
+{
+	return static_cast<int16_t>(lroundf(std::min(std::max(value, -1.0f), 1.0f) * 32767.0f));
+}
+
+static float SignNotZero(float value)
+{
+	return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+void EncodeOctahedral(const float normal[3], int16_t out[2])
+{
+	//|x| + |y| + |z| = 1인 8면체에 투영하고, 아래 반쪽은 바깥 삼각형으로 접음
+	float sum = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+	if (sum == 0.0f)
+	{
+		out[0] = out[1] = 0;
+		return;
+	}
+	float x = normal[0] / sum, y = normal[1] / sum;
+	if (normal[2] < 0.0f)
+	{
+		float foldX = (1.0f - fabsf(y)) * SignNotZero(x);
+		float foldY = (1.0f - fabsf(x)) * SignNotZero(y);
+		x = foldX;
+		y = foldY;
+	}
+	out[0] = ToSnorm16(x);
+	out[1] = ToSnorm16(y);
+}
+
+void DecodeOctahedral(const int16_t in[2], float normal[3])
+{
+	//Shader.hlsl의 OctDecode와 같은 계산
+	float x = std::max(in[0] / 32767.0f, -1.0f);
+	float y = std::max(in[1] / 32767.0f, -1.0f);
+	float z = 1.0f - fabsf(x) - fabsf(y);
+	float t = std::max(-z, 0.0f);
+	x += x >= 0.0f ? -t : t;
+	y += y >= 0.0f ? -t : t;
+
+	float length = sqrtf(x * x + y * y + z * z);
+	normal[0] = x / length;
+	normal[1] = y / length;
+	normal[2] = z / length;
+}
+
+void PositionQuantizationRange(const float center[3], const float extents[3], float boxMin[3], float boxSize[3])
+{
+	for (int k = 0; k < 3; k++)
+	{
+		boxMin[k] = center[k] - extents[k];
+		boxSize[k] = extents[k] * 2.0f;
+	}
+}
+
+void PackVertex(const float pos[3], const float normal[3], const float uv[2], const float boxMin[3], const float boxSize[3], PackedVertex& out)
+{
+	for (int k = 0; k < 3; k++)
+	{
+		float t = boxSize[k] > 0.0f ? (pos[k] - boxMin[k]) / boxSize[k] : 0.0f;
+		out.pos[k] = static_cast<uint16_t>(lroundf(std::min(std::max(t, 0.0f), 1.0f) * 65535.0f));
+	}
+	out.pos[3] = 0;
+	EncodeOctahedral(normal, out.normal);
+	out.uv[0] = FloatToHalf(uv[0]);
+	out.uv[1] = FloatToHalf(uv[1]);
+}
+
+void UnpackVertex(const PackedVertex& packed, const float boxMin[3], const float boxSize[3], float pos[3], float normal[3], float uv[2])
+{
+	for (int k = 0; k < 3; k++)
+		pos[k] = boxMin[k] + packed.pos[k] / 65535.0f * boxSize[k];
+	DecodeOctahedral(packed.normal, normal);
+	uv[0] = HalfToFloat(packed.uv[0]);
+	uv[1] = HalfToFloat(packed.uv[1]);
+}
+
+void RunVertexPackBenchmark(int count)
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	//캐릭터 크기 정도 상자 안의 임의 정점
+	std::vector<float> source(static_cast<size_t>(count) * 8);
+	uint32_t seed = 12345;
+	auto random = [&]() {
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) / 16777216.0f;
+	};
+	const float center[3] = { 0.0f, 90.0f, 0.0f }, extents[3] = { 40.0f, 90.0f, 25.0f };
+	for (int i = 0; i < count; i++)
+	{
+		float* v = &source[static_cast<size_t>(i) * 8];
+		for (int k = 0; k < 3; k++)
+			v[k] = center[k] + (random() * 2.0f - 1.0f) * extents[k];
+		float n[3] = { random() * 2.0f - 1.0f, random() * 2.0f - 1.0f, random() * 2.0f - 1.0f };
+		float length = std::max(sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]), 1e-6f);
+		for (int k = 0; k < 3; k++)
+			v[3 + k] = n[k] / length;
+		v[6] = random();
+		v[7] = random();
+	}
+
+	float boxMin[3], boxSize[3];
+	PositionQuantizationRange(center, extents, boxMin, boxSize);
+	std::vector<PackedVertex> packed(count);
+	auto t0 = clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		const float* v = &source[static_cast<size_t>(i) * 8];
+		PackVertex(v, v + 3, v + 6, boxMin, boxSize, packed[i]);
+	}
+	double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+	double maxPosError = 0.0, maxAngle = 0.0, maxUvError = 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		const float* v = &source[static_cast<size_t>(i) * 8];
+		float pos[3], normal[3], uv[2];
+		UnpackVertex(packed[i], boxMin, boxSize, pos, normal, uv);
+		double dot = 0.0;
+		for (int k = 0; k < 3; k++)
+		{
+			maxPosError = std::max(maxPosError, static_cast<double>(fabsf(pos[k] - v[k])));
+			dot += normal[k] * v[3 + k];
+		}
+		maxAngle = std::max(maxAngle, acos(std::min(dot, 1.0)) * 180.0 / 3.14159265358979);
+		maxUvError = std::max(maxUvError, static_cast<double>(std::max(fabsf(uv[0] - v[6]), fabsf(uv[1] - v[7]))));
+	}
+
+	printf("Vertex pack benchmark : %d vertices, %zu -> %zu bytes per vertex\n", count, sizeof(float) * 9, sizeof(PackedVertex));
+	printf("  Encode : %.2f ms (%.1f ns/vertex)\n", ms, ms * 1e6 / count);
+	printf("  Max error : position %.4f (box %.0f x %.0f x %.0f), normal %.4f deg, uv %.6f\n", maxPosError, boxSize[0], boxSize[1], boxSize[2], maxAngle, maxUvError);
+}
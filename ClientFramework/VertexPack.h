@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+
+//양자화한 정점 (GPU 없이 동작), PACKED_VERTEX일 때 공유 정점 버퍼에 이 모양으로 올린다.
+//위치: 메쉬 AABB 안의 16비트 UNORM (R16G16B16A16_UNORM, w는 안 씀)
+//노멀: 8면체 인코딩 16비트 SNORM 2개 (R16G16_SNORM)
+//UV: half 2개 (R16G16_FLOAT)
+//36바이트 Vertex -> 16바이트
+struct PackedVertex
+{
+	uint16_t pos[4];
+	int16_t normal[2];
+	uint16_t uv[2];
+};
+static_assert(sizeof(PackedVertex) == 16, "packed vertex must match the PACKED_VERTEX input layout");
+
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+//단위 벡터 -> 8면체 좌표 (-1 ~ 1) -> SNORM16, 길이가 1이 아니어도 됨
+void EncodeOctahedral(const float normal[3], int16_t out[2]);
+void DecodeOctahedral(const int16_t in[2], float normal[3]);
+
+//AABB(center, extents) -> 양자화 범위 (최소점, 크기). 굽는 쪽과 그리는 쪽이 같은 값을 쓰도록 이것으로만 계산
+void PositionQuantizationRange(const float center[3], const float extents[3], float boxMin[3], float boxSize[3]);
+
+void PackVertex(const float pos[3], const float normal[3], const float uv[2], const float boxMin[3], const float boxSize[3], PackedVertex& out);
+void UnpackVertex(const PackedVertex& packed, const float boxMin[3], const float boxSize[3], float pos[3], float normal[3], float uv[2]);
+
+//CPU만 쓰는 정점 양자화 비용과 오차 측정, 결과는 콘솔로 출력
+void RunVertexPackBenchmark(int count);
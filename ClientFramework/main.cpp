@@ -1,11 +1,58 @@
 #include "Client.h"
 
+//GPU 없이 CPU 쪽 비용만 재는 벤치마크
+//ClientFramework.exe --xxx-bench [인자] : 인자를 생략하거나 0 이하면 기본값
+struct BenchCommand
+{
+	const char* flag;
+	int defaultArg;
+	void (*run)(int arg);
+};
+
+static const BenchCommand g_benchCommands[] =
+{
+	{ "--cull-bench", 10000, RunCullBenchmark }, //컬링 비용 (오브젝트 수)
+	{ "--simplify-bench", 300, RunSimplifyBenchmark }, //LOD 만드는 비용 (격자 크기)
+	{ "--meshopt-bench", 300, RunMeshOptimizeBenchmark }, //정점 합치기, 캐시 순서 비용 (격자 크기)
+	{ "--mip-bench", 2048, RunMipBenchmark }, //밉 만드는 비용 (텍스처 크기)
+	{ "--bc-bench", 2048, RunBcBenchmark }, //텍스처 압축 비용과 화질 (텍스처 크기)
+	{ "--vpack-bench", 1000000, RunVertexPackBenchmark }, //정점 양자화 비용과 오차 (정점 수)
+	{ "--indirect-check", 0, RunIndirectLayoutCheck }, //ExecuteIndirect 인자 배치 검사 (GPU 없이)
+};
+
+//명령줄이 벤치마크 플래그면 콘솔을 열고 실행한 뒤 true
+static bool RunBenchCommand(const char* cmdLine)
+{
+	for (const BenchCommand& command : g_benchCommands)
+	{
+		size_t length = strlen(command.flag);
+		if (strncmp(cmdLine, command.flag, length) != 0 || (cmdLine[length] != '\0' && cmdLine[length] != ' '))
+			continue;
+
+		int arg = cmdLine[length] == ' ' ? atoi(cmdLine + length + 1) : 0;
+		AllocConsole();
+		freopen("CONOUT$", "wt", stdout);
+		command.run(arg > 0 ? arg : command.defaultArg);
+		printf("Press enter to exit\n");
+		freopen("CONIN$", "rt", stdin);
+		getchar();
+		return true;
+	}
+	return false;
+}
+
 int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, LPSTR lpszCmdLine, int nCmdShow)
 {
+	if (RunBenchCommand(lpszCmdLine))
+		return 0;
+
 	Client client;
-	//Ŭ̾Ʈ ʱȭ
+	//ClientFramework.exe --capture <file> : 서버에서 받은 패킷 기록, 로그인 응답도 남도록 접속 전에 엶
+	if (strncmp(lpszCmdLine, "--capture ", 10) == 0)
+		client.dxEngine.networkPtr->capture.open(lpszCmdLine + 10, CAPTURE_SC);
+	//클라이언트 초기화
 	client.Init(hInst, nCmdShow);
-	// Ӹ Ʈ
+	//매 프레임마다 업데이트
 	MSG msg = { 0 };
 	while (msg.message != WM_QUIT)
 	{
@@ -16,7 +63,7 @@ int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, LPSTR lpszCmdLine, int
 		}
 		else
 		{
-			// Ӹ ׸
+			//매 프레임마다 그리기
 			client.Update();
 		}
 	}
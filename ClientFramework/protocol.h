@@ -1,63 +0,0 @@
-#pragma once
-constexpr int PORT_NUM = 4000;
-constexpr int BUF_SIZE = 200;
-constexpr int NAME_SIZE = 20;
-
-constexpr int MAX_USER = 10;
-
-// Packet ID
-constexpr char CS_LOGIN = 0;
-constexpr char CS_MOVE = 1;
-
-constexpr char SC_LOGIN_OK = 11;
-constexpr char SC_ADD_OBJECT = 12;
-constexpr char SC_REMOVE_OBJECT = 13;
-constexpr char SC_MOVE_OBJECT = 14;
-
-#pragma pack (push, 1)
-struct CS_LOGIN_PACKET {
-	unsigned char size;
-	char	type;
-	char	name[NAME_SIZE];
-};
-
-struct CS_MOVE_PACKET {
-	unsigned char size;
-	char	type;
-	float	degree;
-	float	x;
-	float	y;
-	float	z;
-	unsigned  client_time;
-};
-
-struct SC_LOGIN_OK_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-	float	x, y, z;
-};
-
-struct SC_ADD_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int		id;
-	float	x, y, z;
-	char	name[NAME_SIZE];
-};
-
-struct SC_REMOVE_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-};
-
-struct SC_MOVE_OBJECT_PACKET {
-	unsigned char size;
-	char	type;
-	int	id;
-	float	x, y, z;
-	unsigned int client_time;
-};
-
-#pragma pack (pop)
\ No newline at end of file
@@ -0,0 +1,80 @@
+// GPU frustum culling
+// One thread per object slot: test the bounding sphere against the six frustum planes,
+// pick a LOD from the projected sphere size, append visible instances to their
+// (mesh, LOD) range in gVisibleInstances and bump that range's InstanceCount in the
+// ExecuteIndirect argument buffer.
+
+// argument buffer layout, passed from the C++ IndirectCommand struct at compile time
+#ifndef INDIRECT_COMMAND_STRIDE
+#define INDIRECT_COMMAND_STRIDE 48
+#endif
+#ifndef INDIRECT_INSTANCE_COUNT_OFFSET
+#define INDIRECT_INSTANCE_COUNT_OFFSET 32
+#endif
+
+struct CullInstance
+{
+    float4x4 world;
+    float4 sphere; // xyz center, w radius (world space)
+    uint mesh;
+    uint3 padding;
+};
+
+struct InstanceData
+{
+    float4x4 world;
+};
+
+cbuffer CULL_B0 : register(b0)
+{
+    float4 gPlanes[6];
+    float4 gEyePosition; // xyz camera position, w projection _22
+    float4 gLodScreenSize; // switch to the next LOD below these sizes (descending)
+    uint gInstanceCount;
+    uint gInstanceCapacity; // slots per (mesh, LOD) in gVisibleInstances
+    uint gLodCount;
+    uint gMeshCount;
+};
+
+StructuredBuffer<CullInstance> gSceneInstances : register(t0);
+RWStructuredBuffer<InstanceData> gVisibleInstances : register(u0);
+RWByteAddressBuffer gIndirectArgs : register(u1);
+
+[numthreads(64, 1, 1)]
+void CS_Main(uint3 dispatchID : SV_DispatchThreadID)
+{
+    if (dispatchID.x >= gInstanceCount)
+        return;
+
+    // empty slot or an object that is not drawn (mesh = 0xffffffff)
+    CullInstance instance = gSceneInstances[dispatchID.x];
+    if (instance.mesh >= gMeshCount)
+        return;
+
+    [unroll]
+    for (int i = 0; i < 6; i++)
+    {
+        if (dot(gPlanes[i].xyz, instance.sphere.xyz) + gPlanes[i].w < -instance.sphere.w)
+            return;
+    }
+
+    // same rule as SelectLod() in MeshSimplify.cpp
+    float dist = length(instance.sphere.xyz - gEyePosition.xyz);
+    float screenSize = dist <= instance.sphere.w ? 1.0f : instance.sphere.w * gEyePosition.w / dist;
+    uint lod = 0;
+    while (lod + 1 < gLodCount && screenSize < gLodScreenSize[lod])
+        lod++;
+
+    uint command = instance.mesh * gLodCount + lod;
+    uint slot;
+    uint countAddress = command * INDIRECT_COMMAND_STRIDE + INDIRECT_INSTANCE_COUNT_OFFSET;
+    gIndirectArgs.InterlockedAdd(countAddress, 1, slot);
+    if (slot >= gInstanceCapacity)
+    {
+        // range is full: undo the increment so InstanceCount ends at gInstanceCapacity
+        // (the counter never drops below the capacity, so slots below it stay unique)
+        gIndirectArgs.InterlockedAdd(countAddress, 0xffffffff);
+        return;
+    }
+    gVisibleInstances[command * gInstanceCapacity + slot].world = instance.world;
+}
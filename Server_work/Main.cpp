@@ -7,10 +7,14 @@
 #include <unordered_set>
 #include <windows.h>
 #include <string>
+#include <random>
 
 #include "protocol.h"
 #include "Over_EXP.h"
 #include "Session.h"
+#include "PacketCapture.h"
+#include "PacketDispatch.h"
+#include "Replay.h"
 
 #pragma comment(lib, "WS2_32.lib")
 #pragma comment(lib, "MSWSock.lib")
@@ -20,7 +24,14 @@ using namespace std;
 HANDLE g_h_iocp;
 SOCKET g_s_socket;
 
+//이동 패킷 전용 UDP 소켓, 받기는 CS_UDP_HELLO 하나뿐
+SOCKET g_udp_socket;
+OVER_EXP g_udp_over;
+SOCKADDR_IN g_udp_from;
+int g_udp_from_len;
+
 array<SESSION, MAX_USER> clients;
+CAPTURE_WRITER g_capture;
 
 void disconnect(int c_id);
 
@@ -38,100 +49,128 @@ int get_new_client_id()
 	return -1;
 }
 
-void process_packet(int c_id, char* packet)
+unsigned int new_udp_token()
 {
-	switch (packet[1]) {
-	case CS_LOGIN: {
-		CS_LOGIN_PACKET* p = reinterpret_cast<CS_LOGIN_PACKET*>(packet);
-		clients[c_id]._sl.lock();
-		if (clients[c_id]._s_state == ST_FREE) {
-			clients[c_id]._sl.unlock();
-			break;
-		}
-		if (clients[c_id]._s_state == ST_INGAME) {
-			clients[c_id]._sl.unlock();
-			disconnect(c_id);
-			break;
-		}
+	thread_local mt19937 rng{ random_device{}() };
+	unsigned int token = 0;
+	while (0 == token) token = rng();
+	return token;
+}
 
-		strcpy_s(clients[c_id]._name, p->name);
-		clients[c_id].x = 0;
-		clients[c_id].y = 0;
-		clients[c_id].z = 0;
-		clients[c_id].degree = 0;
-		clients[c_id].send_login_ok_packet(c_id, 0, 0, 0, 0);
-		clients[c_id]._s_state = ST_INGAME;
-		clients[c_id]._sl.unlock();
+void do_udp_recv()
+{
+	DWORD recv_flag = 0;
+	memset(&g_udp_over._over, 0, sizeof(g_udp_over._over));
+	g_udp_over._wsabuf.len = BUF_SIZE;
+	g_udp_over._wsabuf.buf = g_udp_over._send_buf;
+	g_udp_from_len = sizeof(g_udp_from);
+	WSARecvFrom(g_udp_socket, &g_udp_over._wsabuf, 1, 0, &recv_flag, reinterpret_cast<sockaddr*>(&g_udp_from), &g_udp_from_len, &g_udp_over._over, 0);
+}
 
-		for (int i = 0; i < MAX_USER; ++i) {
-			auto& pl = clients[i];
-			if (pl._id == c_id)
-				continue;
-			pl._sl.lock();
-			if (ST_INGAME != pl._s_state) {
-				pl._sl.unlock();
-				continue;
-			}
-			//忡 Ŭ߰ α Ŭ  Ŭ α Ŭ  // c_id -   Ŭ̵
-			pl.send_add_object(c_id, clients[c_id].x, clients[c_id].y, clients[c_id].z, clients[c_id].degree, clients[c_id]._name);
-			//忡 Ŭ߰   Ŭ׸ ٸ Ŭ鿡   
-			clients[c_id].send_add_object(pl._id, pl.x, pl.y, pl.z, pl.degree, pl._name);
+//UDP 데이터그램 하나 = 패킷 하나
+void process_udp_packet(char* packet, int num_bytes)
+{
+	CS_UDP_HELLO_PACKET p;
+	if (num_bytes != wire_size<CS_UDP_HELLO_PACKET>()) return;
+	if (false == read_packet(packet, p)) return;
+
+	for (auto& pl : clients) {
+		pl._sl.lock();
+		if (ST_INGAME == pl._s_state && pl._udp_token == p.udp_token) {
+			//이후 이 세션에 보내는 이동 패킷은 UDP로
+			pl._udp_addr = g_udp_from;
+			pl._udp_on = true;
+			pl.send_udp_packet<SC_UDP_HELLO_OK_PACKET>(pl._udp_token);
 			pl._sl.unlock();
+			return;
 		}
+		pl._sl.unlock();
+	}
+}
 
-		break;
+void on_login(SESSION& cl, const CS_LOGIN_PACKET& p)
+{
+	int c_id = cl._id;
+	cl._sl.lock();
+	if (cl._s_state == ST_FREE) {
+		cl._sl.unlock();
+		return;
 	}
-	case CS_MOVE: {
-		CS_MOVE_PACKET* p = reinterpret_cast<CS_MOVE_PACKET*>(packet);
-		float x = p->x;
-		float y = p->y;
-		float z = p->z;
-		float degree = p->degree;
-		/*switch (p->direction) {
-		case 0:
-		{
-			y--;
-			break;
-		}
-		case 1:
-		{
-			y++;
-			break;
-		}
-		case 2:
-		{
-			x--;
-			break;
-		}
-		case 3:
-		{
-			x++;
-			break;
-		}
-		}*/
-
-		clients[c_id].x = x;
-		clients[c_id].y = y;
-		clients[c_id].z = z;
-		clients[c_id].degree = degree;
-		
-		//clients[c_id].send_move_packet(c_id, x, y);
-
-		for (auto& pl : clients) {
-			if (pl._id == c_id) continue;
-			pl._sl.lock();
-			if (ST_INGAME != pl._s_state) {
-				pl._sl.unlock();
-				continue;
-			}
-			pl.send_move_packet(c_id, x, y, z, degree);
+	if (cl._s_state == ST_INGAME) {
+		cl._sl.unlock();
+		disconnect(c_id);
+		return;
+	}
+
+	strcpy_s(cl._name, p.name);
+	cl.x = 0;
+	cl.y = 0;
+	cl.z = 0;
+	cl.degree = 0;
+	cl._udp_token = new_udp_token();
+	cl._udp_on = false;
+	cl.clear_view();
+	cl.send_login_ok_packet(c_id, 0, 0, 0, 0);
+	cl._s_state = ST_INGAME;
+	cl._sl.unlock();
+
+	for (int i = 0; i < MAX_USER; ++i) {
+		auto& pl = clients[i];
+		if (pl._id == c_id)
+			continue;
+		pl._sl.lock();
+		if (ST_INGAME != pl._s_state) {
 			pl._sl.unlock();
+			continue;
 		}
-		break;
+		//서버입장에서 클라추가시 로그인한 클라를 제외한 모든클라한테 로그인한 클라정보 전송 // c_id - 현재 접속한 클라아이디
+		pl.send_add_object(c_id, cl.x, cl.y, cl.z, cl.degree, cl._name);
+		//서버입장에서 클라추가시 현재 접속한 클라한테만 다른 클라들에 대한 정보 전송
+		cl.send_add_object(pl._id, pl.x, pl.y, pl.z, pl.degree, pl._name);
+		pl._sl.unlock();
 	}
+}
+
+//한 번의 recv에 같이 들어온 이동 패킷들, 최종 위치만 반영하고 브로드캐스트는 한 번
+void on_move_batch(SESSION& cl, const CS_MOVE_PACKET* ps, int count)
+{
+	int c_id = cl._id;
+	const CS_MOVE_PACKET& p = ps[count - 1];
+	float x = p.x;
+	float y = p.y;
+	float z = p.z;
+	float degree = p.degree;
+
+	cl.x = x;
+	cl.y = y;
+	cl.z = z;
+	cl.degree = degree;
+	unsigned short move_seq = ++cl._move_seq;
+
+	for (auto& pl : clients) {
+		if (pl._id == c_id) continue;
+		pl._sl.lock();
+		if (ST_INGAME != pl._s_state) {
+			pl._sl.unlock();
+			continue;
+		}
+		pl.send_move_packet(c_id, x, y, z, degree, move_seq);
+		pl._sl.unlock();
 	}
 }
 
+//새 opcode는 핸들러를 만들고 여기에 한 줄 추가
+constexpr auto g_dispatcher = make_dispatcher<SESSION>(CS_PACKET_SIZE,
+	ON_PACKET<CS_LOGIN_PACKET, on_login>{},
+	ON_PACKET_BATCH<CS_MOVE_PACKET, on_move_batch>{});
+
+//패킷 하나 처리 (리플레이용), 잘못된 패킷이면 false
+bool process_packet(int c_id, char* packet)
+{
+	int size = static_cast<unsigned char>(packet[0]);
+	return size == dispatch_packets(g_dispatcher, clients[c_id], packet, size);
+}
+
 void disconnect(int c_id)
 {
 	clients[c_id]._sl.lock();
@@ -141,6 +180,8 @@ void disconnect(int c_id)
 	}
 	closesocket(clients[c_id]._socket);
 	clients[c_id]._s_state = ST_FREE;
+	clients[c_id]._udp_on = false;
+	clients[c_id]._udp_token = 0;
 	clients[c_id]._sl.unlock();
 
 	for (auto& pl : clients) {
@@ -150,11 +191,7 @@ void disconnect(int c_id)
 			pl._sl.unlock();
 			continue;
 		}
-		SC_REMOVE_OBJECT_PACKET p;
-		p.id = c_id;
-		p.size = sizeof(p);
-		p.type = SC_REMOVE_OBJECT;
-		pl.do_send(&p);
+		pl.send_remove_object(c_id);
 		pl._sl.unlock();
 	}
 }
@@ -169,6 +206,10 @@ void do_worker()
 		OVER_EXP* ex_over = reinterpret_cast<OVER_EXP*>(over);
 		int client_id = static_cast<int>(key);
 		if (FALSE == ret) {
+			if (ex_over->_comp_type == OP_UDP_RECV) { //ICMP port unreachable 등, 다시 받기만 하면 됨
+				do_udp_recv();
+				continue;
+			}
 			if (ex_over->_comp_type == OP_ACCEPT) cout << "Accept Error";
 			else {
 				cout << "GQCS Error on client[" << key << "]\n";
@@ -205,18 +246,24 @@ void do_worker()
 			if (0 == num_bytes) disconnect(client_id);
 			int remain_data = num_bytes + clients[key]._prev_remain;
 			char* p = ex_over->_send_buf;
-			while (remain_data > 0) {
-				int packet_size = p[0];
-				if (packet_size <= remain_data) {
-					process_packet(static_cast<int>(key), p);
-					p = p + packet_size;
-					remain_data = remain_data - packet_size;
+			if (g_capture.is_open()) {
+				for (int offset = 0; remain_data - offset >= 1; ) {
+					int packet_size = static_cast<unsigned char>(p[offset]);
+					if (0 == packet_size || packet_size > remain_data - offset) break;
+					g_capture.write(static_cast<int>(key), p + offset);
+					offset += packet_size;
 				}
-				else break;
 			}
+			int used = dispatch_packets(g_dispatcher, clients[key], p, remain_data);
+			if (-1 == used) { //모르는 opcode나 길이가 안 맞는 패킷
+				cout << "Invalid packet from client[" << key << "]\n";
+				disconnect(client_id);
+				break;
+			}
+			remain_data -= used;
 			clients[key]._prev_remain = remain_data;
 			if (remain_data > 0) {
-				memcpy(ex_over->_send_buf, p, remain_data);
+				memmove(ex_over->_send_buf, p + used, remain_data);
 			}
 			clients[key].do_recv();
 			break;
@@ -225,12 +272,28 @@ void do_worker()
 			if (0 == num_bytes) disconnect(client_id);
 			delete ex_over;
 			break;
+		case OP_UDP_RECV:
+			process_udp_packet(ex_over->_send_buf, static_cast<int>(num_bytes));
+			do_udp_recv();
+			break;
 		}
 	}
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+	// Server_work.exe --capture <file>          : 받은 패킷을 파일로 기록
+	// Server_work.exe --replay <file> [speed]   : 기록된 패킷을 소켓 없이 재생
+	if (argc >= 3 && 0 == strcmp(argv[1], "--replay")) {
+		float speed = (argc >= 4) ? static_cast<float>(atof(argv[3])) : 1.0f;
+		run_replay(argv[2], speed);
+		return 0;
+	}
+	if (argc >= 3 && 0 == strcmp(argv[1], "--capture")) {
+		if (g_capture.open(argv[2], CAPTURE_CS)) cout << "Capturing packets to " << argv[2] << "\n";
+		else cout << "Cannot open capture file " << argv[2] << "\n";
+	}
+
 	WSADATA WSAData;
 	WSAStartup(MAKEWORD(2, 2), &WSAData);
 	g_s_socket = WSASocket(AF_INET, SOCK_STREAM, 0, NULL, 0, WSA_FLAG_OVERLAPPED);
@@ -253,6 +316,12 @@ int main()
 	a_over._wsabuf.buf = reinterpret_cast<CHAR*>(c_socket);
 	AcceptEx(g_s_socket, c_socket, a_over._send_buf, 0, addr_size + 16, addr_size + 16, 0, &a_over._over);
 
+	g_udp_socket = WSASocket(AF_INET, SOCK_DGRAM, IPPROTO_UDP, NULL, 0, WSA_FLAG_OVERLAPPED);
+	bind(g_udp_socket, reinterpret_cast<sockaddr*>(&server_addr), sizeof(server_addr));
+	CreateIoCompletionPort(reinterpret_cast<HANDLE>(g_udp_socket), g_h_iocp, 9998, 0);
+	g_udp_over._comp_type = OP_UDP_RECV;
+	do_udp_recv();
+
 	vector <thread> worker_threads;
 	for (int i = 0; i < 6; ++i)
 		worker_threads.emplace_back(do_worker);
@@ -260,6 +329,7 @@ int main()
 	for (auto& th : worker_threads)
 		th.join();
 
+	closesocket(g_udp_socket);
 	closesocket(g_s_socket);
 	WSACleanup();
 }
\ No newline at end of file
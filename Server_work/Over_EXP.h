@@ -6,7 +6,7 @@
 #include <Windows.h>
 #include "protocol.h"
 
-enum COMP_TYPE { OP_ACCEPT, OP_RECV, OP_SEND };
+enum COMP_TYPE { OP_ACCEPT, OP_RECV, OP_SEND, OP_UDP_RECV };
 
 class OVER_EXP {
 public:
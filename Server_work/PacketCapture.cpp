@@ -0,0 +1,85 @@
+#include "PacketCapture.h"
+
+// 레코드가 이만큼 쌓이면 파일로 내보냄 (서버는 정상 종료 경로가 없다)
+constexpr unsigned int CAPTURE_FLUSH_COUNT = 256;
+
+CAPTURE_WRITER::~CAPTURE_WRITER()
+{
+	close();
+}
+
+bool CAPTURE_WRITER::open(const char* path, unsigned char direction)
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	_file.open(path, std::ios::binary | std::ios::trunc);
+	if (!_file.is_open()) return false;
+
+	CAPTURE_FILE_HEADER header;
+	header.magic = CAPTURE_MAGIC;
+	header.version = CAPTURE_VERSION;
+	header.direction = direction;
+	header.reserved = 0;
+	_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	_prev_time = std::chrono::steady_clock::now();
+	_unflushed = 0;
+	return true;
+}
+
+void CAPTURE_WRITER::close()
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	if (_file.is_open()) _file.close();
+}
+
+void CAPTURE_WRITER::write(int session, const char* packet)
+{
+	unsigned char size = static_cast<unsigned char>(packet[0]);
+	if (size < 2) return;
+
+	std::lock_guard<std::mutex> lock(_lock);
+	if (!_file.is_open()) return;
+
+	//시간은 락 안에서 재야 파일 안의 순서와 시간이 어긋나지 않음
+	auto now = std::chrono::steady_clock::now();
+	long long delta = std::chrono::duration_cast<std::chrono::microseconds>(now - _prev_time).count();
+	_prev_time = now;
+
+	CAPTURE_RECORD_HEADER rec;
+	rec.delta_us = delta > 0xFFFFFFFFLL ? 0xFFFFFFFFu : static_cast<unsigned int>(delta);
+	rec.session = static_cast<unsigned short>(session);
+	_file.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+	_file.write(packet, size);
+
+	if (++_unflushed >= CAPTURE_FLUSH_COUNT) {
+		_file.flush();
+		_unflushed = 0;
+	}
+}
+
+bool CAPTURE_READER::open(const char* path)
+{
+	_file.open(path, std::ios::binary);
+	if (!_file.is_open()) return false;
+
+	CAPTURE_FILE_HEADER header;
+	if (!_file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+	if (header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION) return false;
+	_direction = header.direction;
+	return true;
+}
+
+bool CAPTURE_READER::read_next(CAPTURE_RECORD& rec)
+{
+	CAPTURE_RECORD_HEADER header;
+	if (!_file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+
+	//패킷 크기는 패킷의 첫 바이트
+	if (!_file.read(rec.packet, 1)) return false;
+	unsigned char size = static_cast<unsigned char>(rec.packet[0]);
+	if (size < 2) return false;
+	if (!_file.read(rec.packet + 1, size - 1)) return false;
+
+	rec.delta_us = header.delta_us;
+	rec.session = header.session;
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <fstream>
+#include <chrono>
+#include <mutex>
+
+// 캡처 파일 포맷 (리틀 엔디안)
+// 파일 헤더 : magic(4) version(2) direction(1) reserved(1)
+// 레코드    : 직전 레코드와의 시간차 us(4) 세션 id(2) 패킷 원본(packet[0] 바이트)
+constexpr unsigned int CAPTURE_MAGIC = 0x50414350; // "PCAP"
+constexpr unsigned short CAPTURE_VERSION = 2; // 2 : direction 추가, SC 패킷에 view_gen
+constexpr int CAPTURE_MAX_PACKET = 256;
+
+// 어느 쪽이 받은 패킷인지, 리플레이는 CS 캡처(서버가 기록)만 받음
+constexpr unsigned char CAPTURE_CS = 0; // 서버가 받은 클라이언트 -> 서버 패킷
+constexpr unsigned char CAPTURE_SC = 1; // 클라이언트가 받은 서버 -> 클라이언트 패킷
+
+#pragma pack (push, 1)
+struct CAPTURE_FILE_HEADER {
+	unsigned int	magic;
+	unsigned short	version;
+	unsigned char	direction;
+	unsigned char	reserved;
+};
+
+struct CAPTURE_RECORD_HEADER {
+	unsigned int	delta_us;
+	unsigned short	session;
+};
+#pragma pack (pop)
+
+struct CAPTURE_RECORD {
+	unsigned int	delta_us;
+	int				session;
+	char			packet[CAPTURE_MAX_PACKET];
+};
+
+// 조립이 끝난 패킷을 시간과 함께 기록, 여러 워커 스레드에서 동시에 호출 가능
+class CAPTURE_WRITER {
+	std::ofstream	_file;
+	std::mutex		_lock;
+	std::chrono::steady_clock::time_point _prev_time;
+	unsigned int	_unflushed = 0;
+public:
+	~CAPTURE_WRITER();
+	bool open(const char* path, unsigned char direction);
+	void close();
+	bool is_open() const { return _file.is_open(); }
+	void write(int session, const char* packet);
+};
+
+// 캡처 파일을 레코드 단위로 읽음
+class CAPTURE_READER {
+	std::ifstream	_file;
+	unsigned char	_direction = CAPTURE_CS;
+public:
+	bool open(const char* path);
+	unsigned char direction() const { return _direction; }
+	bool read_next(CAPTURE_RECORD& rec);
+};
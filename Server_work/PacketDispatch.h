@@ -0,0 +1,98 @@
+#pragma once
+#include "PacketSchema.h"
+
+// opcode로 바로 찾는 패킷 핸들러 테이블
+// 핸들러는 컴파일 타임에 등록하고, 호출 전에 스키마의 와이어 크기로 길이를 검사한다.
+//
+//	void on_login(SESSION& cl, const CS_LOGIN_PACKET& p);
+//	void on_move_batch(SESSION& cl, const CS_MOVE_PACKET* ps, int count);
+//	constexpr auto dispatcher = make_dispatcher<SESSION>(CS_PACKET_SIZE,
+//		ON_PACKET<CS_LOGIN_PACKET, on_login>{}, ON_PACKET_BATCH<CS_MOVE_PACKET, on_move_batch>{});
+//
+// 배치 핸들러는 버퍼 안에 연달아 있는 같은 opcode 패킷을 한 번에 받는다.
+
+constexpr int MAX_PACKET_BATCH = BUF_SIZE / 2;
+
+template<class P, auto Fn> struct ON_PACKET {};
+template<class P, auto Fn> struct ON_PACKET_BATCH {};
+
+template<class Ctx>
+struct PACKET_DISPATCHER {
+	using HANDLER = void(*)(Ctx& ctx, const char* packet);
+	using BATCH_HANDLER = void(*)(Ctx& ctx, const char* const* packets, int count);
+
+	std::array<unsigned char, 256>	sizes = {};
+	std::array<HANDLER, 256>		handlers = {};
+	std::array<BATCH_HANDLER, 256>	batch_handlers = {};
+};
+
+template<class Ctx, class P, auto Fn>
+void invoke_packet(Ctx& ctx, const char* packet)
+{
+	P p;
+	read_packet(packet, p); //길이와 타입은 dispatch_packets에서 이미 검사함
+	Fn(ctx, p);
+}
+
+template<class Ctx, class P, auto Fn>
+void invoke_packet_batch(Ctx& ctx, const char* const* packets, int count)
+{
+	P ps[MAX_PACKET_BATCH];
+	for (int i = 0; i < count; ++i)
+		read_packet(packets[i], ps[i]);
+	Fn(ctx, ps, count);
+}
+
+template<class Ctx, class P, auto Fn>
+constexpr void register_handler(PACKET_DISPATCHER<Ctx>& d, ON_PACKET<P, Fn>)
+{
+	d.handlers[static_cast<unsigned char>(PACKET_SCHEMA<P>::type)] = &invoke_packet<Ctx, P, Fn>;
+}
+
+template<class Ctx, class P, auto Fn>
+constexpr void register_handler(PACKET_DISPATCHER<Ctx>& d, ON_PACKET_BATCH<P, Fn>)
+{
+	d.batch_handlers[static_cast<unsigned char>(PACKET_SCHEMA<P>::type)] = &invoke_packet_batch<Ctx, P, Fn>;
+}
+
+template<class Ctx, class... Regs>
+constexpr PACKET_DISPATCHER<Ctx> make_dispatcher(const std::array<unsigned char, 256>& sizes, Regs... regs)
+{
+	PACKET_DISPATCHER<Ctx> d;
+	(register_handler(d, regs), ...);
+	//핸들러가 없는 opcode는 크기 0 = 잘못된 패킷으로 취급
+	for (int i = 0; i < 256; ++i)
+		d.sizes[i] = (d.handlers[i] != nullptr || d.batch_handlers[i] != nullptr) ? sizes[i] : 0;
+	return d;
+}
+
+// buf의 완성된 패킷을 모두 처리하고 처리한 바이트 수를 반환
+// 모르는 opcode나 길이가 스키마와 다른 패킷이 있으면 -1 (연결을 끊을 것)
+template<class Ctx>
+int dispatch_packets(const PACKET_DISPATCHER<Ctx>& d, Ctx& ctx, const char* buf, int len)
+{
+	int offset = 0;
+	while (len - offset >= 2) {
+		unsigned char size = static_cast<unsigned char>(buf[offset]);
+		unsigned char type = static_cast<unsigned char>(buf[offset + 1]);
+		if (0 == d.sizes[type] || size != d.sizes[type]) return -1;
+		if (size > len - offset) break;
+
+		if (nullptr != d.batch_handlers[type]) {
+			const char* run[MAX_PACKET_BATCH];
+			int count = 0;
+			while (count < MAX_PACKET_BATCH && len - offset >= size
+				&& static_cast<unsigned char>(buf[offset]) == size
+				&& static_cast<unsigned char>(buf[offset + 1]) == type) {
+				run[count++] = buf + offset;
+				offset += size;
+			}
+			d.batch_handlers[type](ctx, run, count);
+		}
+		else {
+			d.handlers[type](ctx, buf + offset);
+			offset += size;
+		}
+	}
+	return offset;
+}
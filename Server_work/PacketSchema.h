@@ -0,0 +1,197 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "protocol.h"
+
+// 패킷 스키마
+// protocol.h의 구조체마다 opcode와 필드 순서를 한 번만 적어두면
+// 와이어 크기 검사, opcode별 크기 테이블, 리틀 엔디안 읽기/쓰기가 컴파일 타임에 만들어진다.
+// 모든 패킷은 size(1) type(1) 뒤에 필드가 선언 순서대로 빈틈없이 붙는다.
+
+template<auto... Members>
+struct FIELDS {};
+
+template<class P>
+struct PACKET_SCHEMA; // 패킷마다 특수화 (아래 DEFINE_PACKET_SCHEMA)
+
+template<class... Ps>
+struct PACKET_LIST {};
+
+template<auto Member>
+struct MEMBER_TYPE;
+template<class C, class T, T C::* Member>
+struct MEMBER_TYPE<Member> { using type = T; };
+template<auto Member>
+using member_t = typename MEMBER_TYPE<Member>::type;
+
+#define DEFINE_PACKET_SCHEMA(PACKET, TYPE, ...)			\
+template<> struct PACKET_SCHEMA<PACKET> {				\
+	static constexpr char type = TYPE;					\
+	using fields = FIELDS<__VA_ARGS__>;					\
+};
+
+DEFINE_PACKET_SCHEMA(CS_LOGIN_PACKET, CS_LOGIN,
+	&CS_LOGIN_PACKET::name)
+DEFINE_PACKET_SCHEMA(CS_MOVE_PACKET, CS_MOVE,
+	&CS_MOVE_PACKET::degree, &CS_MOVE_PACKET::x, &CS_MOVE_PACKET::y, &CS_MOVE_PACKET::z, &CS_MOVE_PACKET::client_time)
+DEFINE_PACKET_SCHEMA(CS_UDP_HELLO_PACKET, CS_UDP_HELLO,
+	&CS_UDP_HELLO_PACKET::udp_token)
+DEFINE_PACKET_SCHEMA(SC_LOGIN_OK_PACKET, SC_LOGIN_OK,
+	&SC_LOGIN_OK_PACKET::id, &SC_LOGIN_OK_PACKET::view_gen, &SC_LOGIN_OK_PACKET::x, &SC_LOGIN_OK_PACKET::y, &SC_LOGIN_OK_PACKET::z, &SC_LOGIN_OK_PACKET::degree, &SC_LOGIN_OK_PACKET::udp_token)
+DEFINE_PACKET_SCHEMA(SC_ADD_OBJECT_PACKET, SC_ADD_OBJECT,
+	&SC_ADD_OBJECT_PACKET::id, &SC_ADD_OBJECT_PACKET::view_gen, &SC_ADD_OBJECT_PACKET::x, &SC_ADD_OBJECT_PACKET::y, &SC_ADD_OBJECT_PACKET::z, &SC_ADD_OBJECT_PACKET::degree, &SC_ADD_OBJECT_PACKET::name)
+DEFINE_PACKET_SCHEMA(SC_REMOVE_OBJECT_PACKET, SC_REMOVE_OBJECT,
+	&SC_REMOVE_OBJECT_PACKET::id)
+DEFINE_PACKET_SCHEMA(SC_MOVE_OBJECT_PACKET, SC_MOVE_OBJECT,
+	&SC_MOVE_OBJECT_PACKET::id, &SC_MOVE_OBJECT_PACKET::view_gen, &SC_MOVE_OBJECT_PACKET::x, &SC_MOVE_OBJECT_PACKET::y, &SC_MOVE_OBJECT_PACKET::z, &SC_MOVE_OBJECT_PACKET::degree, &SC_MOVE_OBJECT_PACKET::client_time, &SC_MOVE_OBJECT_PACKET::move_seq)
+DEFINE_PACKET_SCHEMA(SC_UDP_HELLO_OK_PACKET, SC_UDP_HELLO_OK,
+	&SC_UDP_HELLO_OK_PACKET::udp_token)
+
+using CS_PACKETS = PACKET_LIST<CS_LOGIN_PACKET, CS_MOVE_PACKET, CS_UDP_HELLO_PACKET>;
+using SC_PACKETS = PACKET_LIST<SC_LOGIN_OK_PACKET, SC_ADD_OBJECT_PACKET, SC_REMOVE_OBJECT_PACKET, SC_MOVE_OBJECT_PACKET, SC_UDP_HELLO_OK_PACKET>;
+
+// 와이어 크기 = size + type + 필드 크기 합
+template<auto... M>
+constexpr size_t fields_size(FIELDS<M...>) { return (size_t(0) + ... + sizeof(member_t<M>)); }
+
+template<class P>
+constexpr size_t wire_size() { return 2 + fields_size(typename PACKET_SCHEMA<P>::fields{}); }
+
+template<class P>
+constexpr bool check_packet()
+{
+	static_assert(std::is_trivially_copyable_v<P>, "packet must be POD");
+	static_assert(wire_size<P>() == sizeof(P), "schema field list does not match the packet struct (missing field or padding)");
+	static_assert(wire_size<P>() <= BUF_SIZE, "packet does not fit in BUF_SIZE");
+	return true;
+}
+
+template<class... Ps>
+constexpr bool check_packets(PACKET_LIST<Ps...>) { return (check_packet<Ps>() && ...); }
+
+static_assert(check_packets(CS_PACKETS{}));
+static_assert(check_packets(SC_PACKETS{}));
+
+// opcode -> 와이어 크기 (0이면 없는 opcode), 디스패치 전에 길이 검사용
+template<class... Ps>
+constexpr std::array<unsigned char, 256> make_size_table(PACKET_LIST<Ps...>)
+{
+	std::array<unsigned char, 256> table = {};
+	((table[static_cast<unsigned char>(PACKET_SCHEMA<Ps>::type)] = table[static_cast<unsigned char>(PACKET_SCHEMA<Ps>::type)] == 0
+		? static_cast<unsigned char>(wire_size<Ps>())
+		: throw "duplicate opcode"), ...);
+	return table;
+}
+
+constexpr std::array<unsigned char, 256> CS_PACKET_SIZE = make_size_table(CS_PACKETS{});
+constexpr std::array<unsigned char, 256> SC_PACKET_SIZE = make_size_table(SC_PACKETS{});
+
+// 리틀 엔디안 필드 읽기/쓰기, 리틀 엔디안 CPU에서는 컴파일러가 단순 mov로 바꿔줌
+template<size_t N> struct UINT_OF_SIZE;
+template<> struct UINT_OF_SIZE<1> { using type = unsigned char; };
+template<> struct UINT_OF_SIZE<2> { using type = unsigned short; };
+template<> struct UINT_OF_SIZE<4> { using type = unsigned int; };
+template<> struct UINT_OF_SIZE<8> { using type = unsigned long long; };
+
+template<class T, class A>
+inline void store_field(char* out, const A& value)
+{
+	if constexpr (std::is_array_v<T>) {
+		//문자열 필드, 남는 칸은 0으로 채우고 항상 0으로 끝냄
+		constexpr size_t n = sizeof(T);
+		size_t len = strnlen(value, n - 1);
+		memcpy(out, value, len);
+		memset(out + len, 0, n - len);
+	}
+	else {
+		static_assert(std::is_arithmetic_v<T>, "unsupported field type");
+		using U = typename UINT_OF_SIZE<sizeof(T)>::type;
+		T v = static_cast<T>(value);
+		U bits;
+		memcpy(&bits, &v, sizeof(T));
+		for (size_t i = 0; i < sizeof(T); ++i)
+			out[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+	}
+}
+
+template<class T>
+inline void load_field(const char* in, T& value)
+{
+	if constexpr (std::is_array_v<T>) {
+		memcpy(value, in, sizeof(T));
+		value[sizeof(T) - 1] = 0;
+	}
+	else {
+		using U = typename UINT_OF_SIZE<sizeof(T)>::type;
+		U bits = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+			bits |= static_cast<U>(static_cast<U>(static_cast<unsigned char>(in[i])) << (8 * i));
+		memcpy(&value, &bits, sizeof(T));
+	}
+}
+
+template<class P, auto... M>
+inline void write_fields(const P& p, char* out, FIELDS<M...>)
+{
+	size_t offset = 2;
+	((store_field<member_t<M>>(out + offset, p.*M), offset += sizeof(member_t<M>)), ...);
+}
+
+template<class P, auto... M, class... Args>
+inline void emplace_fields(char* out, FIELDS<M...>, const Args&... args)
+{
+	static_assert(sizeof...(M) == sizeof...(Args), "argument count does not match the packet schema");
+	size_t offset = 2;
+	((store_field<member_t<M>>(out + offset, args), offset += sizeof(member_t<M>)), ...);
+}
+
+template<class P, auto... M>
+inline void read_fields(const char* in, P& p, FIELDS<M...>)
+{
+	size_t offset = 2;
+	((load_field(in + offset, p.*M), offset += sizeof(member_t<M>)), ...);
+}
+
+// size, type이 채워진 빈 패킷
+template<class P>
+inline P make_packet()
+{
+	P p = {};
+	p.size = static_cast<unsigned char>(wire_size<P>());
+	p.type = PACKET_SCHEMA<P>::type;
+	return p;
+}
+
+// 구조체 -> 와이어, 쓴 바이트 수 반환
+template<class P>
+inline int write_packet(const P& p, char* out)
+{
+	out[0] = static_cast<char>(wire_size<P>());
+	out[1] = PACKET_SCHEMA<P>::type;
+	write_fields(p, out, typename PACKET_SCHEMA<P>::fields{});
+	return static_cast<int>(wire_size<P>());
+}
+
+// 필드 값 -> 와이어, 중간 구조체 없이 송신 버퍼에 바로 씀 (인자는 스키마 필드 순서)
+template<class P, class... Args>
+inline int emplace_packet(char* out, const Args&... args)
+{
+	out[0] = static_cast<char>(wire_size<P>());
+	out[1] = PACKET_SCHEMA<P>::type;
+	emplace_fields<P>(out, typename PACKET_SCHEMA<P>::fields{}, args...);
+	return static_cast<int>(wire_size<P>());
+}
+
+// 와이어 -> 구조체, 크기나 타입이 스키마와 다르면 false
+template<class P>
+inline bool read_packet(const char* in, P& p)
+{
+	if (static_cast<unsigned char>(in[0]) != wire_size<P>()) return false;
+	if (in[1] != PACKET_SCHEMA<P>::type) return false;
+	p.size = static_cast<unsigned char>(in[0]);
+	p.type = in[1];
+	read_fields(in, p, typename PACKET_SCHEMA<P>::fields{});
+	return true;
+}
@@ -0,0 +1,70 @@
+#include <array>
+#include <chrono>
+#include <thread>
+#include "Session.h"
+#include "PacketCapture.h"
+#include "Replay.h"
+
+using namespace std;
+
+extern array<SESSION, MAX_USER> clients;
+bool process_packet(int c_id, char* packet);
+
+void run_replay(const char* path, float speed)
+{
+	CAPTURE_READER reader;
+	if (false == reader.open(path)) {
+		cout << "Cannot open capture file " << path << "\n";
+		return;
+	}
+	//클라이언트 --capture 파일은 SC 패킷이라 process_packet에 넣을 수 없음
+	if (CAPTURE_CS != reader.direction()) {
+		cout << path << " is a client capture (server -> client packets), replay needs a server capture\n";
+		return;
+	}
+
+	using clock = chrono::steady_clock;
+	const auto start = clock::now();
+	long long recorded_us = 0;
+	long long process_ns = 0;
+	int packet_count = 0;
+	int skip_count = 0;
+	int invalid_count = 0;
+
+	CAPTURE_RECORD rec;
+	while (reader.read_next(rec)) {
+		recorded_us += rec.delta_us;
+		if (rec.session < 0 || rec.session >= MAX_USER) {
+			skip_count++;
+			continue;
+		}
+
+		//처음 보는 세션은 소켓 없이 접속된 상태로 만듦
+		SESSION& cl = clients[rec.session];
+		cl._sl.lock();
+		if (ST_FREE == cl._s_state) {
+			cl._id = rec.session;
+			cl._socket = INVALID_SOCKET;
+			cl._prev_remain = 0;
+			cl._s_state = ST_ACCEPTED;
+		}
+		cl._sl.unlock();
+
+		if (speed > 0.0f) {
+			auto due = start + chrono::microseconds(static_cast<long long>(recorded_us / speed));
+			this_thread::sleep_until(due);
+		}
+
+		auto t0 = clock::now();
+		if (false == process_packet(rec.session, rec.packet)) invalid_count++;
+		process_ns += chrono::duration_cast<chrono::nanoseconds>(clock::now() - t0).count();
+		packet_count++;
+	}
+
+	long long wall_ms = chrono::duration_cast<chrono::milliseconds>(clock::now() - start).count();
+	cout << "Replay done : " << packet_count << " packets (" << skip_count << " skipped, " << invalid_count << " invalid)\n";
+	cout << "  recorded " << recorded_us / 1000 << " ms, replayed " << wall_ms << " ms\n";
+	cout << "  process_packet total " << process_ns / 1000 << " us";
+	if (packet_count > 0) cout << ", " << process_ns / packet_count << " ns/packet";
+	cout << "\n";
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// 캡처 파일을 소켓 없이 process_packet에 그대로 흘려 넣음
+// speed : 1.0이면 기록된 속도, 2.0이면 두 배속, 0 이하면 대기 없이 최대 속도
+void run_replay(const char* path, float speed);
@@ -1,5 +1,7 @@
 #include "Session.h"
 
+extern SOCKET g_udp_socket;
+
 SESSION::SESSION()
 {
 	_id = -1;
@@ -11,6 +13,12 @@ SESSION::SESSION()
 	_name[0] = 0;
 	_s_state = ST_FREE;
 	_prev_remain = 0;
+	_udp_token = 0;
+	_udp_on = false;
+	memset(&_udp_addr, 0, sizeof(_udp_addr));
+	_move_seq = 0;
+	memset(_view_gen, 0, sizeof(_view_gen)); //재접속해도 이어서 증가하도록 clear_view에서는 지우지 않음
+	clear_view();
 }
 
 SESSION::~SESSION()
@@ -27,55 +35,93 @@ void SESSION::do_recv()
 	WSARecv(_socket, &_recv_over._wsabuf, 1, 0, &recv_flag, &_recv_over._over, 0);
 }
 
-void SESSION::do_send(void* packet)
+void SESSION::clear_view()
+{
+	std::lock_guard<std::mutex> lock(_vl);
+	for (auto& h : _view_handle) h = -1;
+	for (auto& o : _view_owner) o = -1;
+}
+
+int SESSION::add_view(int c_id, unsigned char& gen)
+{
+	std::lock_guard<std::mutex> lock(_vl);
+	if (_view_handle[c_id] != -1) {
+		gen = _view_gen[_view_handle[c_id]];
+		return _view_handle[c_id];
+	}
+	for (int h = 0; h < MAX_VIEW; ++h) {
+		if (_view_owner[h] == -1) {
+			_view_owner[h] = static_cast<short>(c_id);
+			_view_handle[c_id] = static_cast<short>(h);
+			gen = ++_view_gen[h];
+			return h;
+		}
+	}
+	return -1; //빈 핸들이 없으면 이 클라이언트에게는 안 보이는 것으로 취급
+}
+
+int SESSION::get_view(int c_id, unsigned char& gen)
+{
+	std::lock_guard<std::mutex> lock(_vl);
+	int h = _view_handle[c_id];
+	if (h != -1) gen = _view_gen[h];
+	return h;
+}
+
+int SESSION::remove_view(int c_id)
+{
+	std::lock_guard<std::mutex> lock(_vl);
+	int h = _view_handle[c_id];
+	if (h == -1) return -1;
+	_view_owner[h] = -1;
+	_view_handle[c_id] = -1;
+	return h;
+}
+
+void SESSION::post_send(OVER_EXP* sdata)
 {
-	OVER_EXP* sdata = new OVER_EXP{ reinterpret_cast<char*>(packet) };
+	if (INVALID_SOCKET == _socket) { //리플레이 세션은 소켓이 없음
+		delete sdata;
+		return;
+	}
 	WSASend(_socket, &sdata->_wsabuf, 1, 0, 0, &sdata->_over, 0);
 }
 
+void SESSION::do_send_udp(const char* packet, int len)
+{
+	//UDP는 유실돼도 다시 보내지 않음, 다음 이동 패킷이 덮어씀
+	sendto(g_udp_socket, packet, len, 0, reinterpret_cast<sockaddr*>(&_udp_addr), sizeof(_udp_addr));
+}
+
 void SESSION::send_login_ok_packet(int c_id, float x, float y, float z, float degree)
 {
-	SC_LOGIN_OK_PACKET p;
-	p.id = c_id;
-	p.size = sizeof(SC_LOGIN_OK_PACKET);
-	p.type = SC_LOGIN_OK;
-	p.x = x;
-	p.y = y;
-	p.z = z;
-	do_send(&p);
+	//자기 자신도 로컬 핸들로 알려줌
+	unsigned char gen;
+	int handle = add_view(c_id, gen);
+	if (handle == -1) return;
+	send_packet<SC_LOGIN_OK_PACKET>(handle, gen, x, y, z, degree, _udp_token);
 }
 
-void SESSION::send_move_packet(int c_id, float x, float y, float z, float degree)
+void SESSION::send_move_packet(int c_id, float x, float y, float z, float degree, unsigned short move_seq)
 {
-	SC_MOVE_OBJECT_PACKET p;
-	p.id = c_id;
-	p.size = sizeof(SC_MOVE_OBJECT_PACKET);
-	p.type = SC_MOVE_OBJECT;
-	p.x = x;
-	p.y = y;
-	p.z = z;
-	p.degree = degree;
-	do_send(&p);
+	unsigned char gen;
+	int handle = get_view(c_id, gen);
+	if (handle == -1) return;
+	if (_udp_on) send_udp_packet<SC_MOVE_OBJECT_PACKET>(handle, gen, x, y, z, degree, 0, move_seq);
+	else send_packet<SC_MOVE_OBJECT_PACKET>(handle, gen, x, y, z, degree, 0, move_seq);
 }
 
 void SESSION::send_add_object(int c_id, float x, float y, float z, float degree, char* name)
 {
-	SC_ADD_OBJECT_PACKET p;
-	p.id = c_id;
-	p.size = sizeof(SC_ADD_OBJECT_PACKET);
-	p.type = SC_ADD_OBJECT;
-	p.x = x;
-	p.y = y;
-	p.z = z;
-	strcpy_s(p.name, name);
-	do_send(&p);
+	unsigned char gen;
+	int handle = add_view(c_id, gen);
+	if (handle == -1) return;
+	send_packet<SC_ADD_OBJECT_PACKET>(handle, gen, x, y, z, degree, name);
 }
 
 void SESSION::send_remove_object(int c_id)
 {
-	SC_REMOVE_OBJECT_PACKET p;
-	p.id = c_id;
-	p.size = sizeof(SC_REMOVE_OBJECT_PACKET);
-	p.type = SC_REMOVE_OBJECT;
-	do_send(&p);
+	int handle = remove_view(c_id);
+	if (handle == -1) return;
+	send_packet<SC_REMOVE_OBJECT_PACKET>(handle);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <thread>
 #include <iostream>
 #include "protocol.h"
+#include "PacketSchema.h"
 #include "Over_EXP.h"
 
 enum SESSION_STATE { ST_FREE, ST_ACCEPTED, ST_INGAME };
@@ -19,13 +20,49 @@ public:
 	char	_name[NAME_SIZE];
 	int		_prev_remain;
 	std::mutex	_sl;
+
+	//UDP 채널 (이동 패킷 전용), CS_UDP_HELLO를 받은 뒤부터 사용
+	unsigned int	_udp_token;
+	bool			_udp_on;
+	SOCKADDR_IN		_udp_addr;
+	unsigned short	_move_seq;	//이 세션이 움직일 때마다 증가, 받는 쪽에서 오래된 이동 패킷을 버리는 기준
+
+	//시야 안 오브젝트의 전역 id <-> 이 클라이언트 전용 로컬 핸들
+	//SC_ADD_OBJECT 때 핸들을 주고 SC_REMOVE_OBJECT 때 돌려받음
+	std::mutex	_vl;
+	short		_view_handle[MAX_USER];	//전역 id -> 로컬 핸들, -1이면 시야 밖
+	short		_view_owner[MAX_VIEW];	//로컬 핸들 -> 전역 id, -1이면 빈 핸들
+	unsigned char	_view_gen[MAX_VIEW];	//핸들을 새 주인에게 줄 때마다 증가, 이전 주인의 늦은 이동 패킷을 클라이언트가 걸러냄
 public:
 	SESSION();
 	~SESSION();
 	void do_recv();
-	void do_send(void* packet);
+	void clear_view();
+	int add_view(int c_id, unsigned char& gen);
+	int get_view(int c_id, unsigned char& gen);
+	int remove_view(int c_id);
+	void post_send(OVER_EXP* sdata);
+	void do_send_udp(const char* packet, int len);
+
+	//스키마대로 송신 버퍼에 바로 직렬화, 인자는 패킷 필드 순서 (size, type 제외)
+	template<class P, class... Args>
+	void send_packet(const Args&... args)
+	{
+		OVER_EXP* sdata = new OVER_EXP;
+		sdata->_comp_type = OP_SEND;
+		sdata->_wsabuf.len = emplace_packet<P>(sdata->_send_buf, args...);
+		post_send(sdata);
+	}
+
+	template<class P, class... Args>
+	void send_udp_packet(const Args&... args)
+	{
+		char buf[wire_size<P>()];
+		int len = emplace_packet<P>(buf, args...);
+		do_send_udp(buf, len);
+	}
 	void send_login_ok_packet(int c_id, float x, float y, float z, float degree);
-	void send_move_packet(int c_id, float x, float y, float z, float degree);
+	void send_move_packet(int c_id, float x, float y, float z, float degree, unsigned short move_seq);
 	void send_add_object(int c_id, float x, float y, float z, float degree, char* name);
 	void send_remove_object(int c_id);
 };
\ No newline at end of file
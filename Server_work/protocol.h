@@ -4,15 +4,18 @@ constexpr int BUF_SIZE = 200;
 constexpr int NAME_SIZE = 20;
 
 constexpr int MAX_USER = 10;
+constexpr int MAX_VIEW = 10; //클라이언트 하나가 동시에 볼 수 있는 오브젝트 수, SC 패킷의 id는 0 ~ MAX_VIEW-1 사이의 로컬 핸들
 
 // Packet ID
 constexpr char CS_LOGIN = 0;
 constexpr char CS_MOVE = 1;
+constexpr char CS_UDP_HELLO = 2;
 
 constexpr char SC_LOGIN_OK = 11;
 constexpr char SC_ADD_OBJECT = 12;
 constexpr char SC_REMOVE_OBJECT = 13;
 constexpr char SC_MOVE_OBJECT = 14;
+constexpr char SC_UDP_HELLO_OK = 15;
 
 #pragma pack (push, 1)
 struct CS_LOGIN_PACKET {
@@ -31,18 +34,28 @@ struct CS_MOVE_PACKET {
 	unsigned  client_time;
 };
 
+// UDP 채널 등록, 로그인 때 받은 토큰을 UDP로 보냄
+struct CS_UDP_HELLO_PACKET {
+	unsigned char size;
+	char	type;
+	unsigned int udp_token;
+};
+
 struct SC_LOGIN_OK_PACKET {
 	unsigned char size;
 	char	type;
-	int	id;
+	unsigned char id;
+	unsigned char view_gen;	//id(로컬 핸들)를 새로 줄 때마다 바뀜, SC_MOVE_OBJECT와 비교
 	float	x, y, z;
 	float	degree;
+	unsigned int udp_token;
 };
 
 struct SC_ADD_OBJECT_PACKET {
 	unsigned char size;
 	char	type;
-	int		id;
+	unsigned char id;
+	unsigned char view_gen;
 	float	x, y, z;
 	float	degree;
 	char	name[NAME_SIZE];
@@ -51,16 +64,25 @@ struct SC_ADD_OBJECT_PACKET {
 struct SC_REMOVE_OBJECT_PACKET {
 	unsigned char size;
 	char	type;
-	int	id;
+	unsigned char id;
 };
 
 struct SC_MOVE_OBJECT_PACKET {
 	unsigned char size;
 	char	type;
-	int	id;
+	unsigned char id;
+	unsigned char view_gen;	//다르면 핸들의 이전 주인이 보낸 늦은 이동
 	float	x, y, z;
 	float	degree;
 	unsigned int client_time;
+	unsigned short move_seq;
+};
+
+// UDP 채널 등록 응답 (UDP로 옴)
+struct SC_UDP_HELLO_OK_PACKET {
+	unsigned char size;
+	char	type;
+	unsigned int udp_token;
 };
 
 #pragma pack (pop)
\ No newline at end of file
@@ -6,9 +6,9 @@ struct LightInfo
     float4 direction;
 };
 
+// per-frame constants, the world matrix comes from gInstances
 cbuffer TEST_B0 : register(b0)
 {
-    float4x4 gWorld;
     float4x4 gView;
     float4x4 gProjection;
     LightInfo lightInfo;
@@ -17,9 +17,26 @@ cbuffer TEST_B0 : register(b0)
 cbuffer TEST_B1 : register(b1)
 {
     float4 offset;
+    uint gTextureIndex; // material texture, index into gTextures
+    float4 gPositionScale; // PACKED_VERTEX: position = bias + unorm * scale (mesh AABB)
+    float4 gPositionBias;
 };
 
-Texture2D tex_0 : register(t0);
+// per-instance data, indexed by gInstanceBase + SV_InstanceID
+struct InstanceData
+{
+    float4x4 world;
+};
+
+StructuredBuffer<InstanceData> gInstances : register(t0, space1);
+
+cbuffer INSTANCE_B0 : register(b0, space1)
+{
+    uint gInstanceBase;
+};
+
+// bindless: every texture has a fixed slot in one shader-visible heap
+Texture2D gTextures[] : register(t0);
 SamplerState sam_0 : register(s0);
 
 LightInfo CalculateLightColor(float3 viewNormal, float3 viewPos)
@@ -48,12 +65,31 @@ LightInfo CalculateLightColor(float3 viewNormal, float3 viewPos)
     return color;
 }
 
+#if PACKED_VERTEX
+// 16-byte vertex, see VertexPack.h
+struct VS_IN
+{
+    float4 pos : POSITION;   // R16G16B16A16_UNORM inside the mesh AABB
+    float2 normal : NORMAL;  // R16G16_SNORM octahedral
+    float2 uv : TEXCOORD;    // R16G16_FLOAT
+};
+
+// same math as DecodeOctahedral in VertexPack.cpp
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.f ? -t : t;
+    return normalize(n);
+}
+#else
 struct VS_IN
 {
     float3 pos : POSITION;
     float4 normal : NORMAL;
     float2 uv : TEXCOORD;
 };
+#endif
 
 struct VS_OUT
 {
@@ -63,17 +99,24 @@ struct VS_OUT
     float3 viewPos : POSITION;
 };
 
-VS_OUT VS_Main(VS_IN input)
+VS_OUT VS_Main(VS_IN input, uint instanceID : SV_InstanceID)
 {
     VS_OUT output = (VS_OUT)0;
 
-    float4x4 WV = mul(gWorld, gView);
+    float4x4 world = gInstances[gInstanceBase + instanceID].world;
+    float4x4 WV = mul(world, gView);
 
-    input.normal = float4(input.normal.xyz, 0.f);
+#if PACKED_VERTEX
+    float3 pos = gPositionBias.xyz + input.pos.xyz * gPositionScale.xyz;
+    float4 normal = float4(OctDecode(input.normal), 0.f);
+#else
+    float3 pos = input.pos;
+    float4 normal = float4(input.normal.xyz, 0.f);
+#endif
 
-    output.pos = mul(float4(input.pos, 1.f), mul(gWorld , mul(gView, gProjection)));
-    output.viewPos = mul(float4(input.pos, 1.f), WV).xyz;
-    output.viewNormal = normalize(mul(input.normal, WV).xyz);
+    output.pos = mul(float4(pos, 1.f), mul(world, mul(gView, gProjection)));
+    output.viewPos = mul(float4(pos, 1.f), WV).xyz;
+    output.viewNormal = normalize(mul(normal, WV).xyz);
     output.uv = input.uv;
 
     return output;
@@ -81,7 +124,7 @@ VS_OUT VS_Main(VS_IN input)
 
 float4 PS_Main(VS_OUT input) : SV_Target
 {
-    float4 color = tex_0.Sample(sam_0, input.uv);
+    float4 color = gTextures[gTextureIndex].Sample(sam_0, input.uv);
 
     LightInfo totalColor = (LightInfo)0.f;
     LightInfo lightColor = CalculateLightColor(input.viewNormal, input.viewPos);